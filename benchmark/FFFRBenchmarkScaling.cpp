@@ -0,0 +1,120 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../test/FFFRTestData.h"
+#include "FFFrameReader.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Ffr;
+
+constexpr uint32_t framesPerStream = 50;
+
+class BenchScaling : public benchmark::Fixture
+{
+public:
+    void SetUp(::benchmark::State& state)
+    {
+        setLogLevel(LogLevel::Quiet);
+        const auto numStreams = static_cast<uint32_t>(state.range(0));
+        for (uint32_t i = 0; i < numStreams; ++i) {
+            DecoderOptions options;
+            options.m_bufferLength = 4;
+            // Mode 0 is all software, 1 is all cuda, 2 alternates between the two
+            if (state.range(1) == 1 || (state.range(1) == 2 && (i & 1) == 1)) {
+                options.m_type = DecodeType::Cuda;
+                options.m_outputHost = false;
+            }
+            auto stream = Stream::getStream(g_testData[0].m_fileName, options);
+            if (stream == nullptr) {
+                state.SkipWithError("Failed to create input stream");
+                return;
+            }
+            m_streams.emplace_back(std::move(stream));
+        }
+    }
+
+    void TearDown(const ::benchmark::State&)
+    {
+        m_streams.clear();
+    }
+
+    std::vector<std::shared_ptr<Stream>> m_streams;
+};
+
+BENCHMARK_DEFINE_F(BenchScaling, decodeConcurrent)(benchmark::State& state)
+{
+    if (m_streams.empty() || framesPerStream >= m_streams[0]->getTotalFrames()) {
+        state.SkipWithError("Cannot perform required iterations on input stream");
+        return;
+    }
+    double totalStreamTime = 0.0;
+    uint64_t totalFrames = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        // Ignore the seek back to start after each loop
+        for (auto& stream : m_streams) {
+            (void)stream->seek(0);
+        }
+        state.ResumeTiming();
+        std::atomic<bool> failed(false);
+        std::vector<double> streamTimes(m_streams.size(), 0.0);
+        std::vector<std::thread> threads;
+        threads.reserve(m_streams.size());
+        for (size_t i = 0; i < m_streams.size(); ++i) {
+            threads.emplace_back([this, i, &failed, &streamTimes]() {
+                const auto start = std::chrono::high_resolution_clock::now();
+                for (uint32_t j = 0; j < framesPerStream; ++j) {
+                    if (m_streams[i]->getNextFrame() == nullptr) {
+                        failed = true;
+                        return;
+                    }
+                }
+                streamTimes[i] =
+                    std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (failed) {
+            state.SkipWithError("Failed to retrieve valid frame");
+            break;
+        }
+        for (const auto& time : streamTimes) {
+            totalStreamTime += time;
+        }
+        totalFrames += m_streams.size() * framesPerStream;
+    }
+    // Aggregate decode throughput across all streams, and the mean time a single
+    // stream takes to deliver a frame while its peers are running
+    state.counters["fps"] = benchmark::Counter(static_cast<double>(totalFrames), benchmark::Counter::kIsRate);
+    state.counters["frame_ms"] =
+        totalFrames != 0 ? (totalStreamTime * 1000.0) / static_cast<double>(totalFrames) : 0.0;
+}
+
+// Parameters in order are:
+//  1. The number of concurrent streams
+//  2. The decoder mix, 0 for all software, 1 for all cuda, 2 for alternating
+static void customArguments(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(2)->Ranges({{1, 64}, {0, 2}})->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_REGISTER_F(BenchScaling, decodeConcurrent)->Apply(customArguments);
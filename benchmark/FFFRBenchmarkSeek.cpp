@@ -0,0 +1,183 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../test/FFFRTestData.h"
+#include "FFFrameReader.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace Ffr;
+
+constexpr uint32_t iterations = 20;
+
+static double percentile(std::vector<double>& samples, const double fraction)
+{
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto rank = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples[std::min(rank, samples.size() - 1)];
+}
+
+static void reportPercentiles(benchmark::State& state, std::vector<double>& samples)
+{
+    state.counters["p50_ms"] = percentile(samples, 0.50);
+    state.counters["p95_ms"] = percentile(samples, 0.95);
+    state.counters["p99_ms"] = percentile(samples, 0.99);
+}
+
+class BenchSeek : public benchmark::Fixture
+{
+public:
+    void SetUp(::benchmark::State& state)
+    {
+        setLogLevel(LogLevel::Quiet);
+        DecoderOptions options;
+        options.m_bufferLength = static_cast<uint32_t>(state.range(1));
+        if (state.range(2) == 1) {
+            options.m_type = DecodeType::Cuda;
+            options.m_outputHost = false;
+        }
+        m_stream = Stream::getStream(g_testData[0].m_fileName, options);
+        if (m_stream == nullptr) {
+            state.SkipWithError("Failed to create input stream");
+        }
+    }
+
+    void TearDown(const ::benchmark::State&)
+    {
+        m_stream.reset();
+    }
+
+    std::shared_ptr<Stream> m_stream = nullptr;
+};
+
+BENCHMARK_DEFINE_F(BenchSeek, seekRandom)(benchmark::State& state)
+{
+    // Fixed seed so every run performs the identical (mostly backward) seek pattern
+    std::mt19937 generator(734267);
+    std::uniform_int_distribution<int64_t> distribution(0, m_stream->getTotalFrames() - 1);
+    std::vector<double> samples;
+    for (auto _ : state) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            const auto position = distribution(generator);
+            const auto start = std::chrono::high_resolution_clock::now();
+            if (!m_stream->seekFrame(position)) {
+                state.SkipWithError("Failed to seek");
+                break;
+            }
+            if (m_stream->getNextFrame() == nullptr) {
+                state.SkipWithError("Failed to retrieve valid frame");
+                break;
+            }
+            const auto elapsed =
+                std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            samples.emplace_back(elapsed * 1000.0);
+            total += elapsed;
+        }
+        state.SetIterationTime(total);
+    }
+    reportPercentiles(state, samples);
+}
+
+BENCHMARK_DEFINE_F(BenchSeek, seekShortForward)(benchmark::State& state)
+{
+    // Forward steps ranging either side of the seek threshold exercise both the
+    // decode-forward and the container seek paths
+    int64_t position = 0;
+    std::vector<double> samples;
+    for (auto _ : state) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            position += state.range(0);
+            if (position >= m_stream->getTotalFrames()) {
+                position = 0;
+            }
+            const auto start = std::chrono::high_resolution_clock::now();
+            if (!m_stream->seekFrame(position)) {
+                state.SkipWithError("Failed to seek");
+                break;
+            }
+            if (m_stream->getNextFrame() == nullptr) {
+                state.SkipWithError("Failed to retrieve valid frame");
+                break;
+            }
+            const auto elapsed =
+                std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            samples.emplace_back(elapsed * 1000.0);
+            total += elapsed;
+        }
+        state.SetIterationTime(total);
+    }
+    reportPercentiles(state, samples);
+}
+
+BENCHMARK_DEFINE_F(BenchSeek, sampleByIndex)(benchmark::State& state)
+{
+    // Evenly spaced sampling across the whole file, retrieved in small blocks as
+    // done when generating filmstrips/thumbnails
+    constexpr int64_t blockSize = 5;
+    const auto stride = std::max(m_stream->getTotalFrames() / iterations, int64_t{1});
+    std::vector<int64_t> frames;
+    for (int64_t i = 0; i < m_stream->getTotalFrames(); i += stride) {
+        frames.emplace_back(i);
+    }
+    std::vector<double> samples;
+    for (auto _ : state) {
+        double total = 0.0;
+        for (size_t i = 0; i < frames.size(); i += blockSize) {
+            const auto start = &frames.data()[i];
+            const auto end = &frames.data()[std::min(frames.size(), i + blockSize)];
+            const std::vector<int64_t> frameSequence(start, end);
+            const auto timer = std::chrono::high_resolution_clock::now();
+            if (m_stream->getFramesByIndex(frameSequence).size() != frameSequence.size()) {
+                state.SkipWithError("Failed to retrieve valid frame");
+                break;
+            }
+            const auto elapsed =
+                std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - timer).count();
+            samples.emplace_back(elapsed * 1000.0);
+            total += elapsed;
+        }
+        state.SetIterationTime(total);
+    }
+    reportPercentiles(state, samples);
+}
+
+// Parameters in order are:
+//  1. The number of frames to move forward in each seek (ignored by the non-stepped benchmarks)
+//  2. The buffer length
+//  3. Boolean, 1 if cuda decoding should be used
+static void steppedArguments(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(2)->Ranges({{2, 256}, {1, 16}, {0, 1}})->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+static void fixedArguments(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(2)->Ranges({{2, 2}, {1, 16}, {0, 1}})->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_REGISTER_F(BenchSeek, seekRandom)->Apply(fixedArguments);
+
+BENCHMARK_REGISTER_F(BenchSeek, seekShortForward)->Apply(steppedArguments);
+
+BENCHMARK_REGISTER_F(BenchSeek, sampleByIndex)->Apply(fixedArguments);
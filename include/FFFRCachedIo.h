@@ -0,0 +1,110 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRExports.h"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AVIOContext;
+
+namespace Ffr {
+/**
+ * Custom AVIO layer that reads the input in large fixed size blocks and keeps an LRU cache of recently fetched byte
+ * ranges. The large ranged reads amortise per-request latency on network protocols (e.g. HTTP/S3) and the cache lets
+ * the backward packet scans generated by seeking be served from memory instead of the network.
+ * @note Requires a seekable input of known size, @isValid must be checked after construction so callers can fall
+ *  back to default I/O.
+ */
+class CachedIo
+{
+public:
+    /**
+     * Constructor, opens the passed source through FFmpeg protocol I/O and creates the caching context.
+     * @param fileName Filename or URL of the source to open.
+     */
+    FFFRAMEREADER_NO_EXPORT explicit CachedIo(const std::string& fileName) noexcept;
+
+    FFFRAMEREADER_NO_EXPORT ~CachedIo() noexcept;
+
+    FFFRAMEREADER_NO_EXPORT CachedIo(const CachedIo& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT CachedIo(CachedIo&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT CachedIo& operator=(const CachedIo& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT CachedIo& operator=(CachedIo&& other) noexcept = delete;
+
+    /**
+     * Query if the source was successfully opened.
+     * @returns True if valid, false if default I/O should be used instead.
+     */
+    FFFRAMEREADER_NO_EXPORT bool isValid() const noexcept;
+
+    /**
+     * Gets the custom I/O context to be attached to a format context.
+     * @note The context remains owned by this object and must outlive any format context using it.
+     * @returns The I/O context, or nullptr if opening the source failed.
+     */
+    FFFRAMEREADER_NO_EXPORT AVIOContext* getContext() const noexcept;
+
+private:
+    /** A cached block of source data. */
+    struct Block
+    {
+        int64_t m_index;             /**< Zero-based index of the block within the source */
+        std::vector<uint8_t> m_data; /**< The block data (may be short for the final block) */
+    };
+
+    static constexpr uint32_t m_blockSize = 1 << 20; /**< Size of each ranged read, large enough to amortise latency */
+    static constexpr uint32_t m_maxBlocks = 64;      /**< Maximum number of cached blocks */
+
+    /**
+     * Gets the block with the passed index, fetching it from the source on a cache miss.
+     * @param index The block index.
+     * @returns The cached block, or nullptr if the fetch failed.
+     */
+    FFFRAMEREADER_NO_EXPORT const Block* getBlock(int64_t index) noexcept;
+
+    /**
+     * Read callback used by the I/O context, serves reads from the block cache.
+     * @param opaque       The owning CachedIo object.
+     * @param [out] buffer The buffer to fill.
+     * @param size         Maximum number of bytes to read.
+     * @returns The number of bytes read, or a negative AVERROR code.
+     */
+    FFFRAMEREADER_NO_EXPORT static int32_t readPacket(void* opaque, uint8_t* buffer, int32_t size) noexcept;
+
+    /**
+     * Seek callback used by the I/O context, only moves the logical position so cached seeks never touch the source.
+     * @param opaque The owning CachedIo object.
+     * @param offset The seek offset.
+     * @param whence The seek origin (or AVSEEK_SIZE to query the source size).
+     * @returns The new position, or a negative AVERROR code.
+     */
+    FFFRAMEREADER_NO_EXPORT static int64_t seekIo(void* opaque, int64_t offset, int32_t whence) noexcept;
+
+    AVIOContext* m_inner = nullptr;   /**< The underlying protocol I/O used to fetch blocks */
+    AVIOContext* m_context = nullptr; /**< The caching I/O context handed to the format context */
+    int64_t m_size = -1;              /**< Size of the source in bytes */
+    int64_t m_position = 0;           /**< Current logical read position */
+    std::list<Block> m_blocks;        /**< Cached blocks in least recently used order (most recent first) */
+    std::unordered_map<int64_t, std::list<Block>::iterator> m_lookup; /**< Index of cached blocks by block index */
+};
+} // namespace Ffr
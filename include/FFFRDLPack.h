@@ -0,0 +1,90 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+/*
+ * Minimal subset of the DLPack stable C ABI (https://github.com/dmlc/dlpack) used to exchange tensors between
+ * frameworks without copying. The definitions below are binary compatible with the upstream dlpack.h and use its
+ * include guard so either header can satisfy the other.
+ */
+#ifndef DLPACK_DLPACK_H_
+#define DLPACK_DLPACK_H_
+
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The device type in DLDevice. */
+typedef enum
+{
+    kDLCPU = 1,       /**< CPU device */
+    kDLCUDA = 2,      /**< CUDA GPU device */
+    kDLCUDAHost = 3,  /**< Pinned CUDA CPU memory */
+} DLDeviceType;
+
+/** A device for tensor and operator. */
+typedef struct
+{
+    DLDeviceType device_type; /**< The device type the tensor is stored on */
+    int32_t device_id;        /**< The device index */
+} DLDevice;
+
+/** The type code options in DLDataType. */
+typedef enum
+{
+    kDLInt = 0,   /**< Signed integer */
+    kDLUInt = 1,  /**< Unsigned integer */
+    kDLFloat = 2, /**< IEEE floating point */
+} DLDataTypeCode;
+
+/** The data type the tensor can hold. */
+typedef struct
+{
+    uint8_t code;   /**< Type code of the base type (DLDataTypeCode) */
+    uint8_t bits;   /**< Number of bits per element */
+    uint16_t lanes; /**< Number of lanes in the type, used for vector types */
+} DLDataType;
+
+/** Plain C tensor object, does not manage memory. */
+typedef struct
+{
+    void* data;          /**< The data pointer */
+    DLDevice device;     /**< The device of the tensor */
+    int32_t ndim;        /**< Number of dimensions */
+    DLDataType dtype;    /**< The data type of the tensor */
+    int64_t* shape;      /**< The shape of the tensor */
+    int64_t* strides;    /**< Strides of the tensor in number of elements (not bytes) */
+    uint64_t byte_offset; /**< The offset in bytes to the beginning of the data */
+} DLTensor;
+
+/**
+ * C tensor object that manages the memory of a DLTensor. The consumer must call the deleter exactly once when the
+ * tensor is no longer needed.
+ */
+typedef struct DLManagedTensor
+{
+    DLTensor dl_tensor; /**< The tensor being exported */
+    void* manager_ctx;  /**< Context used by the exporter to track ownership */
+    void (*deleter)(struct DLManagedTensor* self); /**< Destructor releasing the underlying memory reference */
+} DLManagedTensor;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DLPACK_DLPACK_H_
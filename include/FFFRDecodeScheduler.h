@@ -0,0 +1,119 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRTypes.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Ffr {
+class DecoderContext;
+class Stream;
+
+/**
+ * Multiplexes many logical streams over a bounded pool of hardware decoder sessions.
+ * Hardware decoder sessions (e.g. NVDEC) are a scarce per-GPU resource. When the number of open sessions reaches the
+ * configured limit the scheduler transparently suspends the least recently used idle stream (releasing its session
+ * back to the pool) so that a new or resuming stream can decode. Suspended streams re-acquire a session and restore
+ * their decode position the next time they are read from, allowing large numbers of mostly idle streams to share a
+ * small number of sessions.
+ */
+class DecodeScheduler
+{
+    friend class Stream;
+
+public:
+    FFFRAMEREADER_NO_EXPORT DecodeScheduler(const DecodeScheduler& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT DecodeScheduler(DecodeScheduler&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT DecodeScheduler& operator=(const DecodeScheduler& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT DecodeScheduler& operator=(DecodeScheduler&& other) noexcept = delete;
+
+    /**
+     * Gets the scheduler singleton.
+     * @returns The scheduler.
+     */
+    FFFRAMEREADER_NO_EXPORT static DecodeScheduler& get() noexcept;
+
+    /**
+     * Sets the maximum number of concurrently open hardware decoder sessions.
+     * @param maxSessions The session limit (0 for unlimited).
+     */
+    FFFRAMEREADER_NO_EXPORT void setMaxSessions(uint32_t maxSessions) noexcept;
+
+    /**
+     * Sets the pool of GPU devices used for automatic stream placement.
+     * @param devices The device indices to use (empty to disable automatic placement).
+     */
+    FFFRAMEREADER_NO_EXPORT void setDevicePool(const std::vector<uint32_t>& devices) noexcept;
+
+    /**
+     * Gets the shared decoder context for the least loaded device in the pool.
+     * @note A single context is created per device and shared by all streams placed on it. The load on the chosen
+     *  device is incremented and must be released with @releaseDevice when the stream is destroyed.
+     * @param       type   The type of decoding to use.
+     * @param [out] device Set to the index of the chosen device.
+     * @returns The device context, or nullptr if no device pool is configured (or context creation failed).
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<DecoderContext> acquireDevice(DecodeType type, uint32_t& device) noexcept;
+
+    /**
+     * Releases a stream placement previously made by @acquireDevice.
+     * @param device The device index the stream was placed on.
+     */
+    FFFRAMEREADER_NO_EXPORT void releaseDevice(uint32_t device) noexcept;
+
+private:
+    FFFRAMEREADER_NO_EXPORT DecodeScheduler() = default;
+
+    FFFRAMEREADER_NO_EXPORT ~DecodeScheduler() = default;
+
+    /**
+     * Acquires a decoder session for a stream, suspending the least recently used idle stream if the pool is full.
+     * @note If all current session holders are busy decoding this blocks until a session can be freed.
+     * @param stream The stream requiring a session.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool acquireSession(Stream* stream) noexcept;
+
+    /**
+     * Releases a streams decoder session back to the pool.
+     * @param stream The stream releasing its session.
+     */
+    FFFRAMEREADER_NO_EXPORT void releaseSession(Stream* stream) noexcept;
+
+    /**
+     * Marks a streams session as recently used so it is not preferred for suspension.
+     * @param stream The stream.
+     */
+    FFFRAMEREADER_NO_EXPORT void touchSession(Stream* stream) noexcept;
+
+    std::mutex m_mutex;                  /**< Synchronises access to the session list and device pool */
+    std::condition_variable m_condition; /**< Signals waiting streams when a session may be available */
+    std::list<Stream*> m_sessions;       /**< Streams currently holding a session, least recently used first */
+    uint32_t m_maxSessions = 0;          /**< Maximum number of open sessions (0 for unlimited) */
+    std::vector<uint32_t> m_devicePool;  /**< Device indices available for automatic stream placement */
+    std::map<uint32_t, std::shared_ptr<DecoderContext>> m_deviceContexts; /**< The shared context for each device */
+    std::map<uint32_t, uint32_t> m_deviceLoad; /**< Number of active streams placed on each device */
+};
+} // namespace Ffr
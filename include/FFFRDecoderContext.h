@@ -27,6 +27,7 @@ namespace Ffr {
 class DecoderContext
 {
     friend class Stream;
+    friend class DecodeScheduler;
 
 public:
     using DecodeType = Ffr::DecodeType;
@@ -55,6 +56,7 @@ private:
     {
         friend class DecoderContext;
         friend class Stream;
+        friend class DecodeScheduler;
 
         FFFRAMEREADER_NO_EXPORT DeviceContextPtr() = default;
 
@@ -63,12 +63,14 @@ public:
      * @param codecType   Type of the codec to encode with.
      * @param quality     The encode quality.
      * @param preset      The encode preset.
-     * @param numThreads  Number of threads to use.
-     * @param gopSize     Size of the gop.
+     * @param numThreads      Number of threads to use.
+     * @param gopSize         Size of the gop.
+     * @param hwFramesContext The hardware frames context of the input frames, or null when encoding host frames.
      */
     FFFRAMEREADER_NO_EXPORT Encoder(const std::string& fileName, uint32_t width, uint32_t height, Rational aspect,
         PixelFormat format, Rational frameRate, int64_t duration, EncodeType codecType, uint8_t quality,
-        EncoderOptions::Preset preset, uint32_t numThreads, uint32_t gopSize, ConstructorLock) noexcept;
+        EncoderOptions::Preset preset, uint32_t numThreads, uint32_t gopSize, AVBufferRef* hwFramesContext,
+        ConstructorLock) noexcept;
 
     /**
      * Query if this object is valid.
@@ -87,6 +89,45 @@ private:
      */
     FFFRAMEREADER_NO_EXPORT bool encodeStream(const std::shared_ptr<Stream>& stream) const noexcept;
 
+    /**
+     * Encodes all frames found in input stream using pipelined decode and encode stages.
+     * @note Decoding runs on a worker thread connected to the encode/mux loop by a bounded frame queue so both
+     *  stages overlap in time.
+     * @param stream The stream.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool encodeStreamPipelined(const std::shared_ptr<Stream>& stream) const noexcept;
+
+    /**
+     * Encodes a stream by transcoding multiple segments of it in parallel.
+     * @note The source is re-opened once per segment so each worker owns an independent decoder/encoder pair.
+     *  Segments are encoded to temporary files next to the output and concatenated (stream copied) when all workers
+     *  have finished.
+     * @param fileName File name of the file to write to.
+     * @param stream   The stream to encode.
+     * @param options  Options for controlling encoding.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT static bool encodeStreamSegmented(
+        const std::string& fileName, const std::shared_ptr<Stream>& stream, const EncoderOptions& options) noexcept;
+
+    /**
+     * Encodes a fixed number of frames from the input streams current position then flushes the encoder.
+     * @param stream    The stream.
+     * @param numFrames Number of frames to encode.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool encodeFrames(const std::shared_ptr<Stream>& stream, int64_t numFrames) const noexcept;
+
+    /**
+     * Concatenates previously encoded segment files into the final output using stream copy.
+     * @param fileName     File name of the file to write to.
+     * @param segmentFiles The segment files in playback order.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT static bool concatenateSegments(
+        const std::string& fileName, const std::vector<std::string>& segmentFiles) noexcept;
+
     /**
      * Encode frame.
      * @param frame The frame.
@@ -17,6 +17,7 @@
 #include "FFFrameReader.h"
 
 #include <memory>
+#include <vector>
 
 struct AVFilterGraph;
 struct AVFilterContext;
@@ -84,6 +85,16 @@ public:
      */
     FFFRAMEREADER_NO_EXPORT bool receiveFrame(FramePtr& frame) const noexcept;
 
+    /**
+     * Sends a block of frames through the filter graph in a single batch. All frames are submitted before the sink is
+     * drained, which amortises the per-invocation graph overhead and allows frame-threaded filters to run across the
+     * whole block. Filtered frames are written back over the inputs in order; inputs that produced no output (e.g.
+     * frames still buffered inside the graph) are left empty so callers can discard them.
+     * @param [in,out] frames The input frames, replaced by the filtered output.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool sendReceiveFrames(const std::vector<FramePtr*>& frames) const noexcept;
+
     /**
      * Gets the width of output frames.
      * @returns The width.
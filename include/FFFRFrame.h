@@ -17,9 +17,12 @@
 #include "FFFRTypes.h"
 
 #include <cstdint>
+#include <memory>
+
+struct DLManagedTensor;
 
 namespace Ffr {
-class Frame
+class Frame : public std::enable_shared_from_this<Frame>
 {
     friend class Stream;
     friend class Filter;
@@ -111,6 +114,16 @@ public:
      */
     FFFRAMEREADER_EXPORT DecodeType getDataType() const noexcept;
 
+    /**
+     * Exports an image plane as a zero-copy DLPack tensor.
+     * @note The tensor references the frames memory directly (device memory for hardware frames) and holds a
+     *  reference to the frame, so the data remains valid until the tensors deleter is called. The caller is
+     *  responsible for calling the deleter exactly once. Only frames retrieved from a stream can be exported.
+     * @param plane The image plane to export. Should be less than @getNumberPlanes.
+     * @returns The managed tensor, or nullptr if the plane is invalid or the export failed.
+     */
+    FFFRAMEREADER_EXPORT DLManagedTensor* toDLPack(uint32_t plane = 0) noexcept;
+
 private:
     FramePtr m_frame;
     int64_t m_timeStamp = 0;
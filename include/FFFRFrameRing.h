@@ -0,0 +1,103 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRExports.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Ffr {
+class Frame;
+
+/**
+ * A bounded lock-free single-producer/single-consumer ring buffer of decoded frames.
+ * @note Only a single producer thread may call @push and only a single consumer thread may call @front, @back and
+ *  @pop. @reserve and @clear are control operations that require both the producer and consumer to be idle.
+ */
+class FrameRing
+{
+public:
+    FFFRAMEREADER_NO_EXPORT FrameRing() = default;
+
+    FFFRAMEREADER_NO_EXPORT ~FrameRing() = default;
+
+    FFFRAMEREADER_NO_EXPORT FrameRing(const FrameRing& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT FrameRing(FrameRing&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT FrameRing& operator=(const FrameRing& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT FrameRing& operator=(FrameRing&& other) noexcept = delete;
+
+    /**
+     * Allocates ring storage for at least the requested number of frames.
+     * @param capacity The minimum required capacity (rounded up to the next power of two).
+     * @returns True if it succeeds, false if allocation failed.
+     */
+    FFFRAMEREADER_NO_EXPORT bool reserve(uint32_t capacity) noexcept;
+
+    /**
+     * Adds a frame to the back of the ring (producer only).
+     * @param frame The frame to add.
+     * @returns True if it succeeds, false if the ring is full.
+     */
+    FFFRAMEREADER_NO_EXPORT bool push(std::shared_ptr<Frame> frame) noexcept;
+
+    /**
+     * Gets the frame at the front of the ring without removing it (consumer only).
+     * @returns The front frame, or nullptr if the ring is empty.
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<Frame> front() const noexcept;
+
+    /**
+     * Gets the most recently added frame without removing it (consumer only).
+     * @returns The back frame, or nullptr if the ring is empty.
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<Frame> back() const noexcept;
+
+    /** Removes the frame at the front of the ring (consumer only). */
+    FFFRAMEREADER_NO_EXPORT void pop() noexcept;
+
+    /**
+     * Gets the number of frames currently held in the ring.
+     * @returns The number of frames.
+     */
+    FFFRAMEREADER_NO_EXPORT uint32_t size() const noexcept;
+
+    /**
+     * Query if the ring contains no frames.
+     * @returns True if empty, false if not.
+     */
+    FFFRAMEREADER_NO_EXPORT bool empty() const noexcept;
+
+    /**
+     * Gets the number of additional frames that can be added before the ring is full.
+     * @returns The available space.
+     */
+    FFFRAMEREADER_NO_EXPORT uint32_t space() const noexcept;
+
+    /** Removes and releases all frames currently held in the ring. */
+    FFFRAMEREADER_NO_EXPORT void clear() noexcept;
+
+private:
+    std::vector<std::shared_ptr<Frame>> m_frames; /**< The ring storage (power of two length) */
+    uint32_t m_mask = 0;                          /**< Index mask used to wrap positions into the storage */
+    std::atomic<uint32_t> m_head = {0};           /**< The next position to read (owned by the consumer) */
+    std::atomic<uint32_t> m_tail = {0};           /**< The next position to write (owned by the producer) */
+};
+} // namespace Ffr
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRTypes.h"
+
+#include <cstdint>
+
+struct AVFrame;
+
+namespace Ffr {
+/**
+ * Crop and bilinearly scale an NV12 CUDA frame into another NV12 CUDA frame entirely on the GPU.
+ * @param          source     The input device frame.
+ * @param [in,out] dest       The output device frame (dimensions define the output resolution).
+ * @param          cropLeft   The offset in pixels from the left of the input frame (must be even).
+ * @param          cropTop    The offset in pixels from the top of the input frame (must be even).
+ * @param          cropWidth  The width in pixels of the cropped input region.
+ * @param          cropHeight The height in pixels of the cropped input region.
+ * @returns True if it succeeds, false if it fails.
+ */
+FFFRAMEREADER_NO_EXPORT bool gpuCropScaleNV12(AVFrame* source, AVFrame* dest, uint32_t cropLeft, uint32_t cropTop,
+    uint32_t cropWidth, uint32_t cropHeight) noexcept;
+} // namespace Ffr
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRTypes.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace Ffr {
+class Frame;
+
+/**
+ * Convert the pixel format of a host (software decoded) frame using the CPU conversion kernels.
+ * @param       frame     The input frame (must be located in host memory).
+ * @param [out] outMem    Memory location to store output (must be allocated with enough size for output frame see
+ *  @getImageSize).
+ * @param       outFormat The pixel format to convert to.
+ * @returns True if it succeeds, false if it fails.
+ */
+FFFRAMEREADER_NO_EXPORT bool hostConvertFormat(
+    const std::shared_ptr<Frame>& frame, uint8_t* outMem, PixelFormat outFormat) noexcept;
+
+/** Planar RGB destination pointers used by the host conversion kernels (written in R, G, B order) */
+template<typename T>
+struct HostRGBPlanes
+{
+    T* m_plane1; /**< The R plane */
+    T* m_plane2; /**< The G plane */
+    T* m_plane3; /**< The B plane */
+};
+
+/**
+ * Convert a single YCbCr sample to RGB and store it to planar output.
+ * @note Uses BT601 coefficients matching the CUDA conversion kernels.
+ * @tparam T uint8_t for RGB8P output or float for normalised RGB32FP output.
+ */
+template<typename T>
+FFFRAMEREADER_NO_EXPORT inline void hostConvertPixel(const uint8_t luma, const uint8_t chromaCb,
+    const uint8_t chromaCr, T* const destR, T* const destG, T* const destB) noexcept
+{
+    const auto y = static_cast<float>(luma);
+    const auto cb = static_cast<float>(chromaCb) - 128.0f;
+    const auto cr = static_cast<float>(chromaCr) - 128.0f;
+    const auto r = y + 1.13983f * cr;
+    const auto g = y - 0.39465f * cb - 0.58060f * cr;
+    const auto b = y + 2.03211f * cb;
+    if constexpr (std::is_same<T, float>::value) {
+        // Normalise float values
+        *destR = std::min(std::max(r / 255.0f, 0.0f), 1.0f);
+        *destG = std::min(std::max(g / 255.0f, 0.0f), 1.0f);
+        *destB = std::min(std::max(b / 255.0f, 0.0f), 1.0f);
+    } else {
+        *destR = static_cast<T>(std::min(std::max(r, 0.0f), 255.0f));
+        *destG = static_cast<T>(std::min(std::max(g, 0.0f), 255.0f));
+        *destB = static_cast<T>(std::min(std::max(b, 0.0f), 255.0f));
+    }
+}
+
+/*
+ * AVX2 variants of the host conversion kernels. These are implemented in a separate translation unit that is
+ * compiled with AVX2 code generation enabled and must only be called when the runtime cpu check has passed.
+ * All steps are specified in elements of the relevant plane type.
+ */
+FFFRAMEREADER_NO_EXPORT void convertNV12ToRGB8PAVX2(const uint8_t* srcY, const uint8_t* srcUV, uint32_t srcStepY,
+    uint32_t srcStepUV, uint32_t width, uint32_t height, HostRGBPlanes<uint8_t> dest, uint32_t destStep) noexcept;
+
+FFFRAMEREADER_NO_EXPORT void convertNV12ToRGB32FPAVX2(const uint8_t* srcY, const uint8_t* srcUV, uint32_t srcStepY,
+    uint32_t srcStepUV, uint32_t width, uint32_t height, HostRGBPlanes<float> dest, uint32_t destStep) noexcept;
+
+FFFRAMEREADER_NO_EXPORT void convertYUV420PToRGB8PAVX2(const uint8_t* srcY, const uint8_t* srcU, const uint8_t* srcV,
+    uint32_t srcStepY, uint32_t srcStepC, uint32_t width, uint32_t height, HostRGBPlanes<uint8_t> dest,
+    uint32_t destStep) noexcept;
+
+FFFRAMEREADER_NO_EXPORT void convertYUV420PToRGB32FPAVX2(const uint8_t* srcY, const uint8_t* srcU, const uint8_t* srcV,
+    uint32_t srcStepY, uint32_t srcStepC, uint32_t width, uint32_t height, HostRGBPlanes<float> dest,
+    uint32_t destStep) noexcept;
+} // namespace Ffr
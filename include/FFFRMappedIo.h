@@ -0,0 +1,94 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRExports.h"
+
+#include <cstdint>
+#include <string>
+
+struct AVIOContext;
+
+namespace Ffr {
+/**
+ * Custom AVIO backend that serves demuxer reads from a read-only memory mapping of the input file. This avoids the
+ * per-read syscalls and kernel buffer copies of the default stdio based I/O and is page-cache friendly for the seek
+ * heavy access patterns generated by stream seeking.
+ * @note Only regular local files can be mapped, @isValid must be checked after construction so callers can fall back
+ *  to default I/O.
+ */
+class MappedIo
+{
+public:
+    /**
+     * Constructor, maps the passed file and creates the custom I/O context.
+     * @param fileName Filename of the file to map.
+     */
+    FFFRAMEREADER_NO_EXPORT explicit MappedIo(const std::string& fileName) noexcept;
+
+    FFFRAMEREADER_NO_EXPORT ~MappedIo() noexcept;
+
+    FFFRAMEREADER_NO_EXPORT MappedIo(const MappedIo& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT MappedIo(MappedIo&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT MappedIo& operator=(const MappedIo& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT MappedIo& operator=(MappedIo&& other) noexcept = delete;
+
+    /**
+     * Query if the file was successfully mapped.
+     * @returns True if valid, false if the mapping failed and default I/O should be used.
+     */
+    FFFRAMEREADER_NO_EXPORT bool isValid() const noexcept;
+
+    /**
+     * Gets the custom I/O context to be attached to a format context.
+     * @note The context remains owned by this object and must outlive any format context using it.
+     * @returns The I/O context, or nullptr if the mapping failed.
+     */
+    FFFRAMEREADER_NO_EXPORT AVIOContext* getContext() const noexcept;
+
+private:
+    /**
+     * Read callback used by the I/O context, copies the next packet data out of the mapping.
+     * @param opaque     The owning MappedIo object.
+     * @param [out] buffer The buffer to fill.
+     * @param size       Maximum number of bytes to read.
+     * @returns The number of bytes read, or a negative AVERROR code.
+     */
+    FFFRAMEREADER_NO_EXPORT static int32_t readPacket(void* opaque, uint8_t* buffer, int32_t size) noexcept;
+
+    /**
+     * Seek callback used by the I/O context.
+     * @param opaque The owning MappedIo object.
+     * @param offset The seek offset.
+     * @param whence The seek origin (or AVSEEK_SIZE to query the file size).
+     * @returns The new position, or a negative AVERROR code.
+     */
+    FFFRAMEREADER_NO_EXPORT static int64_t seekIo(void* opaque, int64_t offset, int32_t whence) noexcept;
+
+    uint8_t* m_data = nullptr;       /**< The mapped file data */
+    int64_t m_size = 0;              /**< Size of the mapped file in bytes */
+    int64_t m_position = 0;          /**< Current read position within the mapping */
+    AVIOContext* m_context = nullptr; /**< The custom I/O context backed by the mapping */
+#ifdef _WIN32
+    void* m_file = nullptr;    /**< Handle to the opened file */
+    void* m_mapping = nullptr; /**< Handle to the file mapping object */
+#else
+    int32_t m_fd = -1; /**< Descriptor of the opened file */
+#endif
+};
+} // namespace Ffr
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFrameReader.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Fmc {
+/**
+ * Produces multiple cropped output views of a single decoded stream. The stream is decoded exactly once and each crop
+ * region is applied as a zero-copy view over the decoded frame data, so producing additional crops from the same
+ * source adds no decode or copy cost. Each view is a normal @Ffr::Frame that shares the decoded data buffers and
+ * remains valid independently of its siblings.
+ */
+class MultiCrop : public std::enable_shared_from_this<MultiCrop>
+{
+public:
+    FFFRAMEREADER_NO_EXPORT MultiCrop() = delete;
+
+    FFFRAMEREADER_EXPORT ~MultiCrop() = default;
+
+    FFFRAMEREADER_NO_EXPORT MultiCrop(const MultiCrop& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT MultiCrop(MultiCrop&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT MultiCrop& operator=(const MultiCrop& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT MultiCrop& operator=(MultiCrop&& other) noexcept = delete;
+
+    /**
+     * Gets a multi-crop view of a stream from a file.
+     * @param fileName Filename of the file to open.
+     * @param cropList The crop regions output for every decoded frame.
+     * @param options  (Optional) Options for controlling decoding. Any global crop/scale in the options is ignored as
+     *  cropping is performed per region instead.
+     * @returns The multi-crop stream if succeeded, nullptr otherwise.
+     */
+    FFFRAMEREADER_EXPORT static std::shared_ptr<MultiCrop> getMultiCrop(const std::string& fileName,
+        const std::vector<Ffr::Crop>& cropList, const Ffr::DecoderOptions& options = Ffr::DecoderOptions()) noexcept;
+
+    class ConstructorLock
+    {
+        friend class MultiCrop;
+    };
+
+    /**
+     * Constructor.
+     * @param stream   The stream to decode from.
+     * @param cropList The crop regions output for every decoded frame.
+     */
+    FFFRAMEREADER_NO_EXPORT MultiCrop(
+        std::shared_ptr<Ffr::Stream> stream, std::vector<Ffr::Crop> cropList, ConstructorLock) noexcept;
+
+    /**
+     * Gets the next frame group from the stream. The stream is advanced by a single frame and one output view is
+     * returned per crop region in list order, all sharing the same decoded frame data and time stamp.
+     * @returns The frame group, empty on end of file or error.
+     */
+    FFFRAMEREADER_EXPORT std::vector<std::shared_ptr<Ffr::Frame>> getNextFrameGroup() noexcept;
+
+    /**
+     * Gets the number of crop regions output per decoded frame.
+     * @returns The number of crops.
+     */
+    FFFRAMEREADER_EXPORT uint32_t getNumCrops() const noexcept;
+
+    /**
+     * Gets the underlying stream being decoded. This can be used to query stream properties or perform seeks which
+     * affect all crop outputs equally.
+     * @returns The stream.
+     */
+    FFFRAMEREADER_EXPORT std::shared_ptr<Ffr::Stream> getStream() const noexcept;
+
+    /**
+     * Seeks the underlying stream to a specific time point.
+     * @param timeStamp Time in micro-seconds to seek to.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_EXPORT bool seek(int64_t timeStamp) noexcept;
+
+    /**
+     * Seeks the underlying stream to a specific frame number.
+     * @param frame The zero-indexed frame number to seek to.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_EXPORT bool seekFrame(int64_t frame) noexcept;
+
+private:
+    std::shared_ptr<Ffr::Stream> m_stream = nullptr; /**< The stream decoded once for all crop outputs */
+    std::vector<Ffr::Crop> m_cropList;               /**< The crop regions output per decoded frame */
+
+    /**
+     * Creates a new frame view referencing another frames data with a crop region applied.
+     * @param frame The decoded frame to create a view of.
+     * @param crop  The crop region to apply.
+     * @returns The cropped frame view, nullptr on failure.
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<Ffr::Frame> cropFrame(
+        const std::shared_ptr<Ffr::Frame>& frame, const Ffr::Crop& crop) const noexcept;
+};
+} // namespace Fmc
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRExports.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+struct AVPacket;
+
+namespace Ffr {
+/**
+ * A bounded lock-free single-producer/single-consumer ring buffer of demuxed packets.
+ * @note Only a single producer thread may call @push and only a single consumer thread may call @front and @pop.
+ *  @reserve and @clear are control operations that require both the producer and consumer to be idle. Packets in the
+ *  ring are owned by it; ownership passes to the consumer on @front/@pop and back to the ring on @push.
+ */
+class PacketRing
+{
+public:
+    FFFRAMEREADER_NO_EXPORT PacketRing() = default;
+
+    FFFRAMEREADER_NO_EXPORT ~PacketRing() noexcept;
+
+    FFFRAMEREADER_NO_EXPORT PacketRing(const PacketRing& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT PacketRing(PacketRing&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT PacketRing& operator=(const PacketRing& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT PacketRing& operator=(PacketRing&& other) noexcept = delete;
+
+    /**
+     * Allocates ring storage for at least the requested number of packets.
+     * @param capacity The minimum required capacity (rounded up to the next power of two).
+     * @returns True if it succeeds, false if allocation failed.
+     */
+    FFFRAMEREADER_NO_EXPORT bool reserve(uint32_t capacity) noexcept;
+
+    /**
+     * Adds a packet to the back of the ring (producer only).
+     * @param packet The packet to add (ownership is taken by the ring).
+     * @returns True if it succeeds, false if the ring is full.
+     */
+    FFFRAMEREADER_NO_EXPORT bool push(AVPacket* packet) noexcept;
+
+    /**
+     * Gets the packet at the front of the ring without removing it (consumer only).
+     * @returns The front packet, or nullptr if the ring is empty.
+     */
+    FFFRAMEREADER_NO_EXPORT AVPacket* front() const noexcept;
+
+    /**
+     * Removes the packet at the front of the ring (consumer only).
+     * @note The consumer takes ownership of the packet previously returned by @front.
+     */
+    FFFRAMEREADER_NO_EXPORT void pop() noexcept;
+
+    /**
+     * Gets the number of packets currently held in the ring.
+     * @returns The number of packets.
+     */
+    FFFRAMEREADER_NO_EXPORT uint32_t size() const noexcept;
+
+    /**
+     * Query if the ring contains no packets.
+     * @returns True if empty, false if not.
+     */
+    FFFRAMEREADER_NO_EXPORT bool empty() const noexcept;
+
+    /**
+     * Gets the number of additional packets that can be added before the ring is full.
+     * @returns The available space.
+     */
+    FFFRAMEREADER_NO_EXPORT uint32_t space() const noexcept;
+
+    /** Removes and frees all packets currently held in the ring. */
+    FFFRAMEREADER_NO_EXPORT void clear() noexcept;
+
+private:
+    std::vector<AVPacket*> m_packets;   /**< The ring storage (power of two length) */
+    uint32_t m_mask = 0;                /**< Index mask used to wrap positions into the storage */
+    std::atomic<uint32_t> m_head = {0}; /**< The next position to read (owned by the consumer) */
+    std::atomic<uint32_t> m_tail = {0}; /**< The next position to write (owned by the producer) */
+};
+} // namespace Ffr
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRExports.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Ffr {
+/**
+ * An index of the time stamps found in a video stream. The index records both the keyframe time stamps and the time
+ * stamps of every frame, and can be persisted to a small sidecar file next to the source so that subsequent opens
+ * avoid re-scanning the file. Keyframes are used to seek directly to the keyframe governing a requested time stamp
+ * instead of relying on demuxer seek guesswork, while the per-frame list provides an exact frame-number mapping for
+ * variable frame rate streams where rational frame rate arithmetic is inaccurate.
+ */
+class SeekIndex
+{
+public:
+    FFFRAMEREADER_NO_EXPORT SeekIndex() = default;
+
+    FFFRAMEREADER_NO_EXPORT ~SeekIndex() = default;
+
+    /**
+     * Adds a keyframe to the index.
+     * @param timeStamp The keyframe time stamp (in the stream time base).
+     */
+    FFFRAMEREADER_NO_EXPORT void addKeyFrame(int64_t timeStamp) noexcept;
+
+    /**
+     * Adds a frame to the index.
+     * @param timeStamp The frame time stamp (in the stream time base).
+     */
+    FFFRAMEREADER_NO_EXPORT void addFrame(int64_t timeStamp) noexcept;
+
+    /**
+     * Marks the index as covering the complete stream.
+     * @note Keyframe lookups only return results once the index is complete.
+     */
+    FFFRAMEREADER_NO_EXPORT void setComplete() noexcept;
+
+    /**
+     * Query if the index covers the complete stream.
+     * @returns True if complete, false if not.
+     */
+    FFFRAMEREADER_NO_EXPORT bool isComplete() const noexcept;
+
+    /**
+     * Gets the number of keyframes held in the index.
+     * @returns The number of keyframes.
+     */
+    FFFRAMEREADER_NO_EXPORT uint32_t getNumKeyFrames() const noexcept;
+
+    /**
+     * Gets the number of frames held in the index.
+     * @returns The number of frames.
+     */
+    FFFRAMEREADER_NO_EXPORT uint32_t getNumFrames() const noexcept;
+
+    /**
+     * Finds the keyframe governing the requested time stamp.
+     * @param       timeStamp The requested time stamp (in the stream time base).
+     * @param [out] keyFrame  The time stamp of the latest keyframe at or before the requested one.
+     * @returns True if a governing keyframe was found, false if the index is incomplete or does not cover the time.
+     */
+    FFFRAMEREADER_NO_EXPORT bool findKeyFrame(int64_t timeStamp, int64_t& keyFrame) const noexcept;
+
+    /**
+     * Gets the exact time stamp of a zero-based frame number. The frame number is counted from the frame at the
+     * streams detected start time so it matches the numbering used by the frame based stream functions.
+     * @param       startTimeStamp The streams detected start time (in the stream time base).
+     * @param       frame          The zero-based frame number.
+     * @param [out] timeStamp      The exact time stamp of the frame (in the stream time base).
+     * @returns True if the frame was found, false if the index is incomplete or does not cover the frame.
+     */
+    FFFRAMEREADER_NO_EXPORT bool findFrameTimeStamp(
+        int64_t startTimeStamp, int64_t frame, int64_t& timeStamp) const noexcept;
+
+    /**
+     * Gets the zero-based frame number governing the requested time stamp.
+     * @param       startTimeStamp The streams detected start time (in the stream time base).
+     * @param       timeStamp      The requested time stamp (in the stream time base).
+     * @param [out] frame          The zero-based number of the latest frame at or before the requested time stamp.
+     * @returns True if a governing frame was found, false if the index is incomplete or does not cover the time.
+     */
+    FFFRAMEREADER_NO_EXPORT bool findFrameNumber(
+        int64_t startTimeStamp, int64_t timeStamp, int64_t& frame) const noexcept;
+
+    /**
+     * Loads a previously saved index from the sidecar file belonging to a source file.
+     * @note The sidecar is rejected if the source file has changed since the index was written.
+     * @param fileName Filename of the source video (not the sidecar itself).
+     * @param index    Zero-based index of the video stream the index belongs to.
+     * @returns True if a valid index was loaded, false otherwise.
+     */
+    FFFRAMEREADER_NO_EXPORT bool load(const std::string& fileName, int32_t index) noexcept;
+
+    /**
+     * Saves the index to the sidecar file belonging to a source file.
+     * @param fileName Filename of the source video (not the sidecar itself).
+     * @param index    Zero-based index of the video stream the index belongs to.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool save(const std::string& fileName, int32_t index) const noexcept;
+
+private:
+    std::vector<int64_t> m_keyFrames; /**< Sorted time stamps of all indexed keyframes (stream time base) */
+    std::vector<int64_t> m_frames;    /**< Sorted time stamps of all indexed frames (stream time base) */
+    bool m_complete = false;          /**< True once the index covers the complete stream */
+
+    /**
+     * Inserts a time stamp into a sorted list, ignoring duplicates.
+     * @param [in,out] list      The sorted list to insert into.
+     * @param          timeStamp The time stamp to insert.
+     */
+    FFFRAMEREADER_NO_EXPORT static void addSorted(std::vector<int64_t>& list, int64_t timeStamp) noexcept;
+
+    /**
+     * Gets the name of the sidecar file used to persist the index for a source file.
+     * @param fileName Filename of the source video.
+     * @returns The sidecar filename.
+     */
+    FFFRAMEREADER_NO_EXPORT static std::string getSidecarFileName(const std::string& fileName) noexcept;
+
+    /**
+     * Gets the size and modification time of a source file used to validate a sidecar.
+     * @param       fileName Filename of the source video.
+     * @param [out] size     The file size in bytes.
+     * @param [out] modified The file modification time.
+     * @returns True if it succeeds, false if the file could not be queried.
+     */
+    FFFRAMEREADER_NO_EXPORT static bool getFileSignature(
+        const std::string& fileName, uint64_t& size, int64_t& modified) noexcept;
+};
+} // namespace Ffr
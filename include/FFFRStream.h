@@ -14,28 +14,42 @@
  * limitations under the License.
  */
 #pragma once
+#include "FFFRFrameRing.h"
+#include "FFFRPacketRing.h"
+#include "FFFRSeekIndex.h"
 #include "FFFRTypes.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <future>
 #include <mutex>
+#include <thread>
 #include <vector>
 
+struct AVBufferPool;
+struct AVBufferRef;
+
 namespace Ffr {
 class DecoderContext;
+class DecodeScheduler;
+class CachedIo;
 class Filter;
 class Frame;
+class MappedIo;
 
-class Stream
+class Stream : public std::enable_shared_from_this<Stream>
 {
     friend class Filter;
     friend class Encoder;
     friend class StreamUtils;
     friend class FFR;
+    friend class DecodeScheduler;
 
 public:
     FFFRAMEREADER_NO_EXPORT Stream() = delete;
 
-    FFFRAMEREADER_EXPORT ~Stream() = default;
+    FFFRAMEREADER_EXPORT ~Stream() noexcept;
 
     FFFRAMEREADER_NO_EXPORT Stream(const Stream& other) = delete;
 
@@ -65,6 +79,12 @@ public:
      * @param bufferLength   Number of frames in the the decode buffer.
      * @param seekThreshold  Maximum number of frames for a forward seek to continue to decode instead of seeking.
      * @param noBufferFlush  True to skip buffer flushing on seeks.
+     * @param asyncDecode    True to decode ahead of the current position using a background worker thread.
+     * @param asyncDemux     True to read container packets using a background worker thread.
+     * @param seekIndex      True to build/load a keyframe index used to optimise seeks.
+     * @param mmapInput      True to read the input file through a read-only memory mapping.
+     * @param cachedInput    True to read the input through a block cached read-ahead I/O layer.
+     * @param fastOpen       True to load expensive container properties from a cached sidecar record.
      * @param decoderContext Pointer to an existing context to be used for hardware decoding.
      * @param outputHost     True to output each frame to host CPU memory (only affects hardware decoding).
      * @param crop           The output cropping or (0) if no crop should be performed.
@@ -73,8 +93,10 @@ public:
      * @param format         The required output pixel format.
      */
     FFFRAMEREADER_NO_EXPORT Stream(const std::string& fileName, uint32_t bufferLength, uint32_t seekThreshold,
-        bool noBufferFlush, const std::shared_ptr<DecoderContext>& decoderContext, bool outputHost, Crop crop,
-        Resolution scale, PixelFormat format, ConstructorLock) noexcept;
+        bool noBufferFlush, bool asyncDecode, bool asyncDemux, bool seekIndex, bool mmapInput, bool cachedInput,
+        bool fastOpen, const std::shared_ptr<DecoderContext>& decoderContext, bool outputHost, Crop crop,
+        Resolution scale,
+        PixelFormat format, ConstructorLock) noexcept;
 
     /**
      * Gets the width of the video stream.
@@ -126,6 +148,22 @@ public:
      */
     FFFRAMEREADER_EXPORT uint32_t getFrameSize() const noexcept;
 
+    /**
+     * Enables or disables scrub mode. In scrub mode the decoder discards all non-key frames so frame retrieval yields
+     * only keyframes at a small fraction of the normal decode cost, which suits timeline scrubbing and thumbnail
+     * generation. Returned frames keep their true frame numbers and time stamps so positions remain comparable with
+     * normal decoding.
+     * @note Takes effect from the next decoded block. Must not be toggled while another thread is reading the stream.
+     * @param scrub True to decode only keyframes, false to restore normal decoding.
+     */
+    FFFRAMEREADER_EXPORT void setScrubMode(bool scrub) noexcept;
+
+    /**
+     * Query if scrub mode is currently enabled.
+     * @returns True if only keyframes are being decoded.
+     */
+    FFFRAMEREADER_EXPORT bool getScrubMode() const noexcept;
+
     /**
      * Gets the type of decoding used.
      * @returns The decode type.
@@ -199,6 +237,21 @@ public:
     FFFRAMEREADER_EXPORT std::vector<std::shared_ptr<Frame>> getFramesByIndex(
         const std::vector<int64_t>& frameSequence) noexcept;
 
+    /**
+     * Gets usage statistics for the internal frame memory pools.
+     * @remark This can be used to determine appropriate buffer lengths when tuning memory usage.
+     * @returns The current pool statistics.
+     */
+    FFFRAMEREADER_EXPORT FramePoolStats getFramePoolStats() noexcept;
+
+    /**
+     * Gets performance counters accumulated while the stream has been used.
+     * @remark The counters are always on and updated with relaxed atomics so the collection overhead is negligible.
+     *  They can be polled periodically in production to attribute where decode time is being spent.
+     * @returns A snapshot of the current counters.
+     */
+    FFFRAMEREADER_EXPORT StreamStats getStats() const noexcept;
+
     /**
      * Query if the stream has reached end of input file.
      * @returns True if end of file, false if not.
@@ -220,6 +273,48 @@ public:
      */
     FFFRAMEREADER_EXPORT bool seekFrame(int64_t frame) noexcept;
 
+    /**
+     * Gets the next frame in the stream asynchronously using the shared task pool.
+     * @remark This allows many streams to progress cooperatively on a small set of worker threads instead of blocking
+     *  one caller thread each. The stream is kept alive until the returned future has completed. If multiple
+     *  asynchronous operations are outstanding on the same stream their relative execution order is unspecified, so
+     *  position dependent calls should wait on the previous future first.
+     * @returns A future holding the next frame, or nullptr if an error occured or end of file reached.
+     */
+    FFFRAMEREADER_EXPORT std::future<std::shared_ptr<Frame>> getNextFrameAsync() noexcept;
+
+    /**
+     * Gets a sequence of frames based on there time stamps asynchronously using the shared task pool.
+     * @param frameSequence The frame sequence. This is a list of absolute times used to specify which frames to
+     *  retrieve (see @getFrames).
+     * @returns A future holding the list of retrieved frames.
+     */
+    FFFRAMEREADER_EXPORT std::future<std::vector<std::shared_ptr<Frame>>> getFramesAsync(
+        const std::vector<int64_t>& frameSequence) noexcept;
+
+    /**
+     * Gets a sequence of frames using frame indices asynchronously using the shared task pool.
+     * @param frameSequence The frame sequence. This is a list of absolute indices used to specify which frames to
+     *  retrieve (see @getFramesByIndex).
+     * @returns A future holding the list of retrieved frames.
+     */
+    FFFRAMEREADER_EXPORT std::future<std::vector<std::shared_ptr<Frame>>> getFramesByIndexAsync(
+        const std::vector<int64_t>& frameSequence) noexcept;
+
+    /**
+     * Seeks the stream to the given time stamp asynchronously using the shared task pool.
+     * @param timeStamp The time stamp to seek to (in micro-seconds).
+     * @returns A future holding true if the seek succeeded, false if it failed.
+     */
+    FFFRAMEREADER_EXPORT std::future<bool> seekAsync(int64_t timeStamp) noexcept;
+
+    /**
+     * Seeks the stream to the given frame number asynchronously using the shared task pool.
+     * @param frame The zero-indexed frame number to seek to.
+     * @returns A future holding true if the seek succeeded, false if it failed.
+     */
+    FFFRAMEREADER_EXPORT std::future<bool> seekFrameAsync(int64_t frame) noexcept;
+
     /**
      * Convert a zero-based frame number to time value represented in microseconds (AV_TIME_BASE).
      * @note This will not be fully accurate when dealing with VFR video streams.
@@ -248,8 +343,14 @@ private:
     bool m_outputHost = true; /**< True to output each frame to host CPU memory (only affects hardware decoding) */
     FramePtr m_tempFrame;     /**< The temporary frame used for decoding */
 
+    std::unique_ptr<MappedIo> m_mappedIo; /**< Optional memory mapped input backing the format context, must outlive
+                                           the format context that reads through it */
+    std::unique_ptr<CachedIo> m_cachedIo; /**< Optional block cached input backing the format context, must outlive
+                                           the format context that reads through it */
     FormatContextPtr m_formatContext;
-    int32_t m_index = -1; /**< Zero-based index of the video stream  */
+    int32_t m_index = -1;   /**< Zero-based index of the video stream  */
+    std::string m_fileName;      /**< Filename of the source video */
+    DecoderOptions m_openOptions; /**< The options the stream was opened with, used to re-open equivalent streams */
     CodecContextPtr m_codecContext;
 
     int64_t m_startTimeStamp = 0;  /**< PTS of the first frame in the stream time base */
@@ -263,8 +364,71 @@ private:
     int64_t m_totalFrames = 0;    /**< Stream video duration in frames */
     int64_t m_totalDuration = 0;  /**< Stream video duration in microseconds (AV_TIME_BASE) */
     int64_t m_seekThreshold = 0;  /**< Time stamp difference for determining if a forward seek should forward decode */
+    bool m_seekThresholdAdaptive = false; /**< True when the threshold is adapted from measured operation costs */
+    float m_avgFrameDecodeTime = 0.0f;    /**< Moving average of the forward decode cost per frame (micro-seconds) */
+    float m_avgSeekTime = 0.0f;           /**< Moving average of a container seek round trip cost (micro-seconds) */
     bool m_noBufferFlush = false; /**< True to skip buffer flushing on seeks */
-    bool m_frameSeekSupported = true; /**< True if frame seek supported */
+    bool m_scrubMode = false;     /**< True to decode only keyframes for fast coarse position scrubbing */
+    bool m_frameSeekSupported = true;  /**< True if frame seek supported */
+    bool m_seekIndexEnabled = false;   /**< True to use the keyframe index to optimise seeks */
+    SeekIndex m_seekIndex;             /**< The keyframe index used to seek directly to governing keyframes */
+
+    bool m_asyncDecode = false; /**< True to decode ahead using a background worker thread */
+    FrameRing m_frameRing; /**< Lock-free ring used to pass decoded frames from the worker to the reader */
+    std::thread m_decodeWorker;                /**< The worker thread used for asynchronous decode-ahead */
+    std::mutex m_workerMutex;                  /**< Synchronises state shared with the decode worker */
+    std::condition_variable m_workerCondition; /**< Signals state changes between reader and decode worker */
+    std::atomic<bool> m_workerRequested = {
+        false};                  /**< True if the worker has been asked to decode the next block */
+    bool m_workerActive = false; /**< True while the worker is decoding a block */
+    bool m_workerShutdown = false; /**< True to instruct the worker to exit */
+    bool m_workerFailed = false;   /**< True if the last asynchronous decode failed */
+    std::atomic<bool> m_consumerWaiting = {false}; /**< True while the reader is blocked on an empty frame ring */
+    std::atomic<bool> m_producerWaiting = {false}; /**< True while the worker is blocked on a full frame ring */
+    std::atomic<bool> m_discardBlock = {false}; /**< True to make the worker discard the block currently in flight */
+
+    bool m_asyncDemux = false; /**< True to read container packets using a background worker thread */
+    PacketRing m_packetRing;   /**< Lock-free ring used to pass packets from the demux worker to the decoder */
+    std::thread m_demuxWorker; /**< The worker thread used to read packets ahead of the decoder */
+    std::mutex m_demuxMutex;   /**< Synchronises state shared with the demux worker */
+    std::condition_variable m_demuxCondition; /**< Signals state changes between decoder and demux worker */
+    bool m_demuxShutdown = false; /**< True to instruct the demux worker to exit */
+    bool m_demuxPaused = false;   /**< True to park the demux worker while the demuxer is repositioned */
+    bool m_demuxIdle = true;      /**< True while the demux worker is not reading a packet */
+    bool m_demuxEof = false;      /**< True once the demux worker has reached the end of the input */
+    int32_t m_demuxError = 0;     /**< First error code returned by the demux worker (0 if none) */
+
+    std::shared_ptr<DecoderContext> m_decoderContext; /**< Device context used to recreate suspended decoders */
+    bool m_sessionManaged = false; /**< True if the hardware decoder session is managed by the decode scheduler */
+    bool m_suspended = false;      /**< True while the hardware decoder session has been released back to the pool */
+    uint32_t m_poolDevice = UINT32_MAX; /**< Device index assigned from the device pool (UINT32_MAX if unpooled) */
+
+    bool m_gpuTransform = false; /**< True to crop/scale device frames directly on the GPU */
+    uint32_t m_gpuCropLeft = 0;  /**< The offset in pixels from the left of the frame for the GPU crop */
+    uint32_t m_gpuCropTop = 0;   /**< The offset in pixels from the top of the frame for the GPU crop */
+    uint32_t m_gpuCropWidth = 0; /**< The width in pixels of the cropped GPU input region */
+    uint32_t m_gpuCropHeight = 0;             /**< The height in pixels of the cropped GPU input region */
+    Resolution m_gpuResolution = {0, 0};      /**< The output resolution of the GPU crop/scale */
+    AVBufferRef* m_gpuFramesContext = nullptr; /**< Hardware frames context used for GPU crop/scale output frames */
+
+    std::mutex m_framePoolMutex;           /**< Synchronises creation/resizing of the frame memory pools */
+    AVBufferPool* m_decodeFramePool = nullptr; /**< Pool of recycled data buffers for decoder output frames */
+    uint32_t m_decodeFramePoolSize = 0;        /**< Size in bytes of each buffer in the decode pool */
+    AVBufferPool* m_transferFramePool = nullptr; /**< Pool of recycled data buffers for hardware frame downloads */
+    uint32_t m_transferFramePoolSize = 0;        /**< Size in bytes of each buffer in the transfer pool */
+    std::atomic<uint32_t> m_decodeFramePoolAllocated = {0};   /**< Number of buffers allocated by the decode pool */
+    std::atomic<uint32_t> m_transferFramePoolAllocated = {0}; /**< Number of buffers allocated by the transfer pool */
+    std::atomic<uint64_t> m_statPacketsDemuxed = {0};  /**< Number of container packets read while decoding */
+    std::atomic<uint64_t> m_statFramesDecoded = {0};   /**< Number of frames output by the decoder */
+    std::atomic<uint64_t> m_statDecodeTime = {0};      /**< Total block decode time (micro-seconds) */
+    std::atomic<uint64_t> m_statFilterTime = {0};      /**< Total filter graph time (micro-seconds) */
+    std::atomic<uint64_t> m_statTransferTime = {0};    /**< Total hardware frame download time (micro-seconds) */
+    std::atomic<uint64_t> m_statSeekCount = {0};       /**< Number of container seeks performed */
+    std::atomic<uint64_t> m_statSeekDistances[4] = {}; /**< Histogram of seek distances in frames */
+    std::atomic<uint32_t> m_statBufferHighWater = {0}; /**< Maximum observed decoded buffer occupancy */
+    std::atomic<uint32_t> m_statBufferLowWater = {UINT32_MAX}; /**< Minimum occupancy when a new block was needed */
+    void* m_transferStream = nullptr;  /**< CUstream used to issue hardware frame downloads asynchronously */
+    bool m_transferPending = false;    /**< True while asynchronous downloads are queued on the transfer stream */
 
     /**
      * Initialises codec parameters needed for future operations.
@@ -272,6 +436,14 @@ private:
      */
     FFFRAMEREADER_NO_EXPORT bool initialise() noexcept;
 
+    /**
+     * Loads the keyframe index from its sidecar file or builds it by scanning the streams packets.
+     * @note Must be called before any frames have been decoded from the stream.
+     * @param fileName Filename of the source video.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool setupSeekIndex(const std::string& fileName) noexcept;
+
     /**
      * Convert a time value represented in microseconds (AV_TIME_BASE) to the stream timebase using start time
      * correction.
@@ -387,13 +559,140 @@ private:
     FFFRAMEREADER_NO_EXPORT int64_t timeStampToTimeNoOffset(int64_t timeStamp) const noexcept;
 
     /**
-     * Decodes the next block of frames into the pong buffer. Once complete swaps the ping/pong buffers.
+     * Gets the exact stream time stamp of a zero-based frame number from the seek index.
+     * @note Unlike @frameToTimeStamp this is exact for VFR streams but is only available when the seek index is
+     *  enabled and complete.
+     * @param       frame     The zero-based frame number.
+     * @param [out] timeStamp The exact time stamp of the frame (in the stream time base, including start time).
+     * @returns True if the frame was found in the index, false otherwise.
+     */
+    FFFRAMEREADER_NO_EXPORT bool frameToTimeStampExact(int64_t frame, int64_t& timeStamp) const noexcept;
+
+    /**
+     * Gets the exact zero-based frame number governing a stream time stamp from the seek index.
+     * @note Unlike @timeStampToFrame this is exact for VFR streams but is only available when the seek index is
+     *  enabled and complete.
+     * @param       timeStamp The time stamp (in the stream time base, including start time).
+     * @param [out] frame     The zero-based number of the latest frame at or before the time stamp.
+     * @returns True if a governing frame was found in the index, false otherwise.
+     */
+    FFFRAMEREADER_NO_EXPORT bool timeStampToFrameExact(int64_t timeStamp, int64_t& frame) const noexcept;
+
+    /**
+     * Releases the hardware decoder session back to the decode scheduler by closing the decoder.
+     * @note Called by the decode scheduler with m_mutex held. The decode position is restored when the session is
+     *  resumed.
+     * @returns True if the session was released, false if the stream cannot currently be suspended.
+     */
+    FFFRAMEREADER_NO_EXPORT bool suspendDecoderSession() noexcept;
+
+    /**
+     * Re-acquires a hardware decoder session from the decode scheduler and recreates the decoder.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool resumeDecoderSession() noexcept;
+
+    /**
+     * Plans the retrieval order for a sequence of frame requests. Requests are processed sorted so clustered
+     * requests become a single forward pass through each GOP instead of thrashing between seeks, with results
+     * written back in the callers original order.
+     * @param frameSequence The requested frame numbers or time stamps.
+     * @returns The request positions in the order they should be retrieved, or empty if planning failed.
+     */
+    FFFRAMEREADER_NO_EXPORT static std::vector<size_t> planFrameSequence(
+        const std::vector<int64_t>& frameSequence) noexcept;
+
+    /**
+     * Decodes the next block of frames into the pong buffer. Once complete swaps the ping/pong buffers (or
+     * publishes the block to the frame ring when asynchronous decode is enabled).
      * @param flushTillTime (Optional) All frames with decoder time stamps before this will be discarded.
      * @param seeking       (Optional) True if called directly after seeking.
      * @returns True if it succeeds, false if it fails.
      */
     FFFRAMEREADER_NO_EXPORT bool decodeNextBlock(int64_t flushTillTime = INT64_MIN, bool seeking = false) noexcept;
 
+    /**
+     * Decodes the next block of frames into the pong buffer without swapping the ping/pong buffers.
+     * @param flushTillTime (Optional) All frames with decoder time stamps before this will be discarded.
+     * @param seeking       (Optional) True if called directly after seeking.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool decodeNextBlockPong(int64_t flushTillTime = INT64_MIN, bool seeking = false) noexcept;
+
+    /**
+     * Starts the background worker thread used when asynchronous decode is enabled.
+     * @note If thread creation fails the stream falls back to synchronous decoding.
+     */
+    FFFRAMEREADER_NO_EXPORT void startDecodeWorker() noexcept;
+
+    /** Stops the background decode worker and waits for it to exit. */
+    FFFRAMEREADER_NO_EXPORT void stopDecodeWorker() noexcept;
+
+    /** Main loop of the background decode worker. */
+    FFFRAMEREADER_NO_EXPORT void decodeWorkerLoop() noexcept;
+
+    /**
+     * Starts the background demux worker thread used when asynchronous demuxing is enabled.
+     * @note If thread creation fails the stream falls back to synchronous demuxing.
+     */
+    FFFRAMEREADER_NO_EXPORT void startDemuxWorker() noexcept;
+
+    /** Stops the background demux worker and waits for it to exit. */
+    FFFRAMEREADER_NO_EXPORT void stopDemuxWorker() noexcept;
+
+    /** Main loop of the background demux worker. */
+    FFFRAMEREADER_NO_EXPORT void demuxWorkerLoop() noexcept;
+
+    /**
+     * Parks the demux worker and discards all queued packets.
+     * @note Must be called before repositioning the demuxer, followed by @resumeDemuxWorker once done.
+     */
+    FFFRAMEREADER_NO_EXPORT void syncDemuxWorker() noexcept;
+
+    /** Resumes packet reading after the demuxer has been repositioned. */
+    FFFRAMEREADER_NO_EXPORT void resumeDemuxWorker() noexcept;
+
+    /**
+     * Gets the next packet from the container, either directly or from the demux worker queue.
+     * @param [out] packet The packet to fill.
+     * @returns 0 if it succeeds, a negative AVERROR code otherwise.
+     */
+    FFFRAMEREADER_NO_EXPORT int32_t readPacket(AVPacket* packet) noexcept;
+
+    /** Requests that the worker decodes the next block into the pong buffer. */
+    FFFRAMEREADER_NO_EXPORT void requestDecodeAhead() noexcept;
+
+    /**
+     * Waits for any in-flight asynchronous decode to complete and discards its output.
+     * @note This must be called before directly accessing the decoder from the reader thread.
+     */
+    FFFRAMEREADER_NO_EXPORT void syncDecodeWorker() noexcept;
+
+    /**
+     * Moves all frames currently in the pong buffer into the frame ring.
+     * @note If the ring is full this blocks until the reader has consumed enough frames.
+     * @returns True if it succeeds, false if the block was discarded due to shutdown or a pending seek.
+     */
+    FFFRAMEREADER_NO_EXPORT bool publishDecodedFrames() noexcept;
+
+    /**
+     * Blocks until the worker has added new frames to the frame ring or the end of the file is reached.
+     * @returns The next frame in the ring, or nullptr if an error occured or end of file reached.
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<Frame> waitFrameRing() noexcept;
+
+    /**
+     * Gets the oldest currently buffered frame without performing any decoding.
+     * @returns The frame, or nullptr if no decoded frames are buffered.
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<Frame> getBufferedFront() noexcept;
+
+    /**
+     * Gets the most recent currently buffered frame without performing any decoding.
+     * @returns The frame, or nullptr if no decoded frames are buffered.
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<Frame> getBufferedBack() noexcept;
+
     /**
      * Decodes any frames currently pending in the decoder.
      * @param [in,out] flushTillTime All frames with decoder time stamps before this will be discarded.
@@ -408,11 +707,68 @@ private:
     FFFRAMEREADER_NO_EXPORT bool processFrames() noexcept;
 
     /**
-     * Process a frame with any required additional filtering/conversion.
+     * Process a frame with any required transform and host download. Filtering is performed separately by
+     * @processFrames which submits the whole block to the filter graph in one batch.
      * @param [in,out] frame The frame.
      * @returns True if it succeeds, false if it fails.
      */
-    FFFRAMEREADER_NO_EXPORT bool processFrame(FramePtr& frame) const noexcept;
+    FFFRAMEREADER_NO_EXPORT bool processFrame(FramePtr& frame) noexcept;
+
+    /**
+     * Codec callback used to supply recycled data buffers for decoded frames.
+     * @param [in,out] context The codec context (opaque must point to the owning stream).
+     * @param [in,out] frame   The frame requiring data buffers.
+     * @param          flags   A combination of AV_GET_BUFFER_FLAG flags.
+     * @returns 0 if it succeeds, a negative AVERROR code otherwise.
+     */
+    FFFRAMEREADER_NO_EXPORT static int32_t poolGetBuffer(AVCodecContext* context, AVFrame* frame, int flags) noexcept;
+
+    /**
+     * Attaches a recycled data buffer to a frame used to receive hardware frame downloads.
+     * @param [in,out] frame  The frame to attach buffers to (format/width/height must already be set).
+     * @returns True if it succeeds, false if a pooled buffer could not be used.
+     */
+    FFFRAMEREADER_NO_EXPORT bool attachTransferBuffer(AVFrame* frame) noexcept;
+
+    /**
+     * Pool callback used to allocate new decoder output buffers while tracking pool usage.
+     * @param opaque Pointer to the owning stream.
+     * @param size   The required buffer size in bytes.
+     * @returns The new buffer, or nullptr on failure.
+     */
+    FFFRAMEREADER_NO_EXPORT static AVBufferRef* allocDecodeBuffer(void* opaque, int32_t size) noexcept;
+
+    /**
+     * Pool callback used to allocate new hardware download buffers while tracking pool usage.
+     * @note Buffers are allocated in pinned (page-locked) memory when the stream has a transfer stream so downloads
+     *  run at full copy bandwidth and can be issued asynchronously.
+     * @param opaque Pointer to the owning stream.
+     * @param size   The required buffer size in bytes.
+     * @returns The new buffer, or nullptr on failure.
+     */
+    FFFRAMEREADER_NO_EXPORT static AVBufferRef* allocTransferBuffer(void* opaque, int32_t size) noexcept;
+
+    /**
+     * Buffer callback used to release a pinned hardware download buffer.
+     * @param opaque Reference to the hardware device context the buffer was allocated under (released on return).
+     * @param data   The buffer memory to free.
+     */
+    FFFRAMEREADER_NO_EXPORT static void freePinnedBuffer(void* opaque, uint8_t* data) noexcept;
+
+    /**
+     * Issues an asynchronous copy of a hardware frame into an attached host buffer on the transfer stream.
+     * @note The copy must be fenced with @syncTransfers before the destination memory is read.
+     * @param [out] dest   The host frame to copy into (must have pooled buffers attached).
+     * @param       source The hardware frame to copy from.
+     * @returns True if the copy was queued, false if the synchronous transfer path must be used instead.
+     */
+    FFFRAMEREADER_NO_EXPORT bool transferFrameAsync(AVFrame* dest, const AVFrame* source) noexcept;
+
+    /**
+     * Waits for all asynchronous downloads queued on the transfer stream to complete.
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool syncTransfers() noexcept;
 
     /**
      * Pops the next available frame from the buffer.
@@ -433,6 +789,25 @@ private:
      */
     FFFRAMEREADER_NO_EXPORT int32_t getSeekThreshold() const noexcept;
 
+    /**
+     * Records the measured cost of a seek operation and adapts the seek threshold.
+     * @note Only used when automatic threshold detection is enabled. The costs of forward decodes and container seeks
+     *  are tracked as exponential moving averages and the threshold is moved to the point where the cheaper strategy
+     *  changes, so seek heavy sessions converge on the fast strategy within a few operations. When a complete seek
+     *  index is available the threshold is additionally bounded below by the observed average keyframe interval as a
+     *  container seek still has to decode forward from the governing keyframe.
+     * @param usedSeek True if the operation used a container seek, false if it forward decoded.
+     * @param frames   The number of frames stepped over when forward decoding (ignored for container seeks).
+     * @param timeUs   The measured operation cost in micro-seconds.
+     */
+    FFFRAMEREADER_NO_EXPORT void updateSeekThreshold(bool usedSeek, int64_t frames, int64_t timeUs) noexcept;
+
+    /**
+     * Records a container seek in the performance counters.
+     * @param distance The seek distance from the current position in frames.
+     */
+    FFFRAMEREADER_NO_EXPORT void recordSeekStats(int64_t distance) noexcept;
+
     /**
      * Return the maximum number of input frames needed by a codec before it can produce output.
      * @param codec The codec.
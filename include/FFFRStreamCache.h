@@ -0,0 +1,111 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRStream.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+
+namespace Ffr {
+/**
+ * A process wide LRU cache of open streams. Opening a stream pays for container probing, codec setup and the duration
+ * scan which can take hundreds of milliseconds, so request serving workloads that repeatedly open the same files
+ * should acquire their streams through the cache instead. A stream acquired from the cache is automatically returned
+ * to it when the caller releases their last reference, and subsequent requests for the same file and options reuse
+ * the warm stream with its position reset to the first frame.
+ * @note A cached stream is only handed to a single caller at a time, concurrent requests for the same file are given
+ *  independently opened streams.
+ */
+class StreamCache
+{
+public:
+    FFFRAMEREADER_NO_EXPORT StreamCache(const StreamCache& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT StreamCache(StreamCache&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT StreamCache& operator=(const StreamCache& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT StreamCache& operator=(StreamCache&& other) noexcept = delete;
+
+    /**
+     * Gets the process wide stream cache.
+     * @returns The stream cache.
+     */
+    FFFRAMEREADER_EXPORT static StreamCache& get() noexcept;
+
+    /**
+     * Sets the maximum number of idle streams kept warm by the cache.
+     * @note When the limit is exceeded the least recently returned stream is closed. A value of 0 disables caching.
+     * @param maxStreams The maximum number of idle streams.
+     */
+    FFFRAMEREADER_EXPORT void setMaxStreams(uint32_t maxStreams) noexcept;
+
+    /**
+     * Gets a stream for the given file, reusing a warm cached stream when one is available.
+     * @note This is a drop in replacement for @Stream::getStream. The returned stream is returned to the cache when
+     *  the last reference to it is released.
+     * @param fileName Filename of the file to open.
+     * @param options  (Optional) Options for controlling decoding.
+     * @returns The stream if succeeded, nullptr otherwise.
+     */
+    FFFRAMEREADER_EXPORT std::shared_ptr<Stream> getStream(
+        const std::string& fileName, const DecoderOptions& options = DecoderOptions()) noexcept;
+
+    /** Closes all idle cached streams. */
+    FFFRAMEREADER_EXPORT void clear() noexcept;
+
+private:
+    /** An idle stream together with the key it was opened with. */
+    struct Entry
+    {
+        std::string m_fileName;      /**< The filename the stream was opened from */
+        DecoderOptions m_options;    /**< The options the stream was opened with */
+        std::shared_ptr<Stream> m_stream; /**< The open stream */
+    };
+
+    FFFRAMEREADER_NO_EXPORT StreamCache() noexcept = default;
+
+    FFFRAMEREADER_NO_EXPORT ~StreamCache() noexcept = default;
+
+    /**
+     * Checks if two sets of decoder options would produce an interchangeable stream.
+     * @note This is stricter than @DecoderOptions::operator== as streams also differ by their output
+     *  cropping/scaling/format and buffering configuration.
+     * @param options The requested options.
+     * @param other   The options a cached stream was opened with.
+     * @returns True if a stream opened with @other can be handed out for a request using @options.
+     */
+    FFFRAMEREADER_NO_EXPORT static bool matches(const DecoderOptions& options, const DecoderOptions& other) noexcept;
+
+    /**
+     * Wraps a stream so that it is returned to the cache when the callers last reference is released.
+     * @param entry The entry holding the stream and its key.
+     * @returns The wrapped stream, or the unwrapped stream if the wrapper could not be created.
+     */
+    FFFRAMEREADER_NO_EXPORT std::shared_ptr<Stream> wrapStream(Entry entry) noexcept;
+
+    /**
+     * Returns a stream to the idle cache, evicting the least recently used entries over the size limit.
+     * @param entry The entry holding the stream and its key.
+     */
+    FFFRAMEREADER_NO_EXPORT void returnStream(Entry&& entry) noexcept;
+
+    std::mutex m_mutex;          /**< Synchronises access to the idle stream list */
+    std::list<Entry> m_streams;  /**< Idle cached streams, most recently used at the front */
+    uint32_t m_maxStreams = 16;  /**< Maximum number of idle streams kept warm */
+};
+} // namespace Ffr
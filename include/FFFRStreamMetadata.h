@@ -0,0 +1,74 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRExports.h"
+
+#include <cstdint>
+#include <string>
+
+namespace Ffr {
+/**
+ * A compact record of the container properties that are expensive to determine when opening a stream. Containers
+ * without reliable headers (e.g. MPEG-TS) require scanning every packet in the file to find the start time stamp,
+ * total frames and duration which dominates open time for long files. The record is persisted to a small sidecar file
+ * next to the source after the first full open so that subsequent opens can skip the scans entirely.
+ */
+class StreamMetadata
+{
+public:
+    FFFRAMEREADER_NO_EXPORT StreamMetadata() = default;
+
+    FFFRAMEREADER_NO_EXPORT ~StreamMetadata() = default;
+
+    /**
+     * Loads a previously saved record from the sidecar file belonging to a source file.
+     * @note The sidecar is rejected if the source file has changed since the record was written.
+     * @param fileName Filename of the source video (not the sidecar itself).
+     * @returns True if a valid record was loaded, false otherwise.
+     */
+    FFFRAMEREADER_NO_EXPORT bool load(const std::string& fileName) noexcept;
+
+    /**
+     * Saves the record to the sidecar file belonging to a source file.
+     * @param fileName Filename of the source video (not the sidecar itself).
+     * @returns True if it succeeds, false if it fails.
+     */
+    FFFRAMEREADER_NO_EXPORT bool save(const std::string& fileName) const noexcept;
+
+    int32_t m_index = -1;          /**< Zero-based index of the video stream the record belongs to */
+    int64_t m_startTimeStamp = 0;  /**< The detected stream start time (in the stream time base) */
+    int64_t m_totalFrames = 0;     /**< The total number of frames in the stream */
+    int64_t m_totalDuration = 0;   /**< The total stream duration (in AV_TIME_BASE units) */
+
+private:
+    /**
+     * Gets the name of the sidecar file used to persist the record for a source file.
+     * @param fileName Filename of the source video.
+     * @returns The sidecar filename.
+     */
+    FFFRAMEREADER_NO_EXPORT static std::string getSidecarFileName(const std::string& fileName) noexcept;
+
+    /**
+     * Gets the size and modification time of a source file used to validate a sidecar.
+     * @param       fileName Filename of the source video.
+     * @param [out] size     The file size in bytes.
+     * @param [out] modified The file modification time.
+     * @returns True if it succeeds, false if the file could not be queried.
+     */
+    FFFRAMEREADER_NO_EXPORT static bool getFileSignature(
+        const std::string& fileName, uint64_t& size, int64_t& modified) noexcept;
+};
+} // namespace Ffr
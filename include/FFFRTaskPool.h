@@ -0,0 +1,80 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "FFFRExports.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ffr {
+/**
+ * A shared pool of worker threads used to execute the asynchronous stream operations. This allows a large number of
+ * streams to progress cooperatively on a small fixed set of threads instead of requiring one blocked thread each.
+ * @note The pool is started lazily on first use and is shared by all streams in the process.
+ */
+class TaskPool
+{
+public:
+    FFFRAMEREADER_NO_EXPORT TaskPool(const TaskPool& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT TaskPool(TaskPool&& other) noexcept = delete;
+
+    FFFRAMEREADER_NO_EXPORT TaskPool& operator=(const TaskPool& other) = delete;
+
+    FFFRAMEREADER_NO_EXPORT TaskPool& operator=(TaskPool&& other) noexcept = delete;
+
+    /**
+     * Gets the process wide task pool.
+     * @returns The task pool.
+     */
+    FFFRAMEREADER_NO_EXPORT static TaskPool& get() noexcept;
+
+    /**
+     * Sets the number of worker threads used by the pool.
+     * @note This only takes effect if called before the first task is submitted, a value of 0 selects the number of
+     *  hardware threads.
+     * @param numThreads Requested number of worker threads (0 for automatic).
+     */
+    FFFRAMEREADER_NO_EXPORT void setNumThreads(uint32_t numThreads) noexcept;
+
+    /**
+     * Adds a task to be executed by the pool.
+     * @param task The task to execute.
+     * @returns True if it succeeds, false if the task could not be queued.
+     */
+    FFFRAMEREADER_NO_EXPORT bool submit(std::function<void()> task) noexcept;
+
+private:
+    FFFRAMEREADER_NO_EXPORT TaskPool() noexcept = default;
+
+    FFFRAMEREADER_NO_EXPORT ~TaskPool() noexcept;
+
+    /** Main loop of each pool worker thread. */
+    FFFRAMEREADER_NO_EXPORT void workerLoop() noexcept;
+
+    std::mutex m_mutex;                      /**< Synchronises access to the task queue and pool state */
+    std::condition_variable m_condition;     /**< Signals queued tasks and shutdown to the workers */
+    std::deque<std::function<void()>> m_tasks; /**< Queue of tasks awaiting execution */
+    std::vector<std::thread> m_workers;      /**< The pool worker threads */
+    uint32_t m_numThreads = 0;               /**< Requested number of worker threads (0 for automatic) */
+    bool m_shutdown = false;                 /**< True to instruct the workers to exit */
+};
+} // namespace Ffr
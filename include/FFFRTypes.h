@@ -39,6 +39,8 @@ enum class EncodeType
 {
     h264,
     h265,
+    h264_nvenc, /**< Hardware h264 encode using NVENC (accepts CUDA device frames directly) */
+    h265_nvenc, /**< Hardware h265 encode using NVENC (accepts CUDA device frames directly) */
 };
 
 struct Resolution
@@ -115,6 +117,35 @@ public:
                                    decoding. This must match the hardware type specified in @m_type. */
     uint32_t m_device = 0;        /**< The device index for the desired hardware device. */
     bool m_outputHost = true;     /**< True to output each frame to host CPU memory (only affects hardware decoding). */
+    bool m_asyncDecode = false;   /**< True to use a background worker thread to decode ahead of the current stream
+                                   position. This allows frame retrieval to return without blocking on a block decode
+                                   provided the worker has kept pace. The stream must only be read from a single
+                                   thread when this is enabled. */
+    bool m_asyncDemux = false;    /**< True to read container packets using a background worker thread that feeds the
+                                   decoder through a bounded packet queue. This hides demuxer I/O latency (e.g.
+                                   network or disk stalls) behind decoding. */
+    bool m_seekIndex = false;     /**< True to build a keyframe index when the stream is opened and use it to seek
+                                   directly to the keyframe governing a requested position. The index is cached in a
+                                   sidecar file next to the source so it only needs to be built once. Recommended for
+                                   random access workloads on containers with poor seeking support (e.g. MKV/TS). */
+    bool m_mmapInput = false;     /**< True to read the input file through a read-only memory mapping instead of the
+                                   default stdio based I/O. This avoids per-read syscalls and buffer copies and is
+                                   page-cache friendly for seek heavy access to local files. Default I/O is used if
+                                   the file cannot be mapped (e.g. non-regular or remote files). */
+    bool m_cachedInput = false;   /**< True to read the input through a block cached read-ahead I/O layer. Data is
+                                   fetched in large ranged reads that amortise per-request latency and recently
+                                   fetched ranges are kept in an LRU cache, so repeated seeks on network sources
+                                   (e.g. HTTP/S3) are served from memory. Ignored if @m_mmapInput is active. */
+    bool m_fastOpen = false;      /**< True to load the stream start time, total frames and duration from a compact
+                                   sidecar record written on the first full open (validated against the source file
+                                   size and modification time). This skips the whole file packet scans these
+                                   properties otherwise require on containers without reliable headers (e.g. MPEG-TS),
+                                   reducing cold open time for long files from seconds to milliseconds. */
+    bool m_scrubMode = false;     /**< True to decode only keyframes by instructing the decoder to discard all
+                                   non-key frames. Intended for timeline scrubbing and thumbnail generation where
+                                   coarse frames are needed quickly, as skipping the intermediate frames decodes at a
+                                   small fraction of the normal cost. Can be toggled at runtime via
+                                   @Stream::setScrubMode. */
 };
 
 class EncoderOptions
@@ -156,6 +187,39 @@ public:
                              but increased encoding time. */
     uint32_t m_numThreads = 0;        /**< Requested number of threads to use for encoding (0 for default) */
     uint32_t m_gopSize = 0;           /**< Requested output gop size (0 for default) */
+    bool m_pipelined = false; /**< True to decode and encode in separate pipelined stages so they overlap in time */
+    uint32_t m_segments = 0; /**< Number of segments to transcode in parallel with independent decoder/encoder pairs
+                             (0 or 1 to disable). The source is split into contiguous frame ranges that are encoded to
+                             temporary files and concatenated into the final output. */
+};
+
+struct PreProcessParams
+{
+    Crop m_crop = {0, 0, 0, 0};     /**< The amount of pixels to crop from each edge of the input frame */
+    Resolution m_scale = {0, 0};    /**< The output resolution (affects scaling, 0 uses the cropped input size) */
+    float m_mean[3] = {0.0f, 0.0f, 0.0f}; /**< Per-channel mean subtracted from the normalised 0..1 RGB values */
+    float m_std[3] = {1.0f, 1.0f, 1.0f};  /**< Per-channel standard deviation the mean-subtracted values are divided by */
+};
+
+struct FramePoolStats
+{
+    uint32_t m_decodeBuffers = 0;      /**< Number of data buffers allocated for decoder output frames */
+    uint32_t m_decodeBufferSize = 0;   /**< Size in bytes of each decoder output buffer */
+    uint32_t m_transferBuffers = 0;    /**< Number of data buffers allocated for hardware frame downloads */
+    uint32_t m_transferBufferSize = 0; /**< Size in bytes of each hardware download buffer */
+};
+
+struct StreamStats
+{
+    uint64_t m_packetsDemuxed = 0;              /**< Number of container packets read while decoding */
+    uint64_t m_framesDecoded = 0;               /**< Number of frames output by the decoder */
+    uint64_t m_decodeTime = 0;                  /**< Total time spent decoding frame blocks (micro-seconds) */
+    uint64_t m_filterTime = 0;                  /**< Total time spent in the filter graph (micro-seconds) */
+    uint64_t m_transferTime = 0;                /**< Total time spent downloading hardware frames (micro-seconds) */
+    uint64_t m_seekCount = 0;                   /**< Number of container seeks performed */
+    uint64_t m_seekDistances[4] = {0, 0, 0, 0}; /**< Histogram of seek distances in frames (<16, <128, <1024, rest) */
+    uint32_t m_bufferHighWater = 0;             /**< Maximum observed decoded buffer occupancy in frames */
+    uint32_t m_bufferLowWater = 0; /**< Minimum buffer occupancy observed when a new block was required in frames */
 };
 
 class FormatContextPtr
@@ -44,6 +44,34 @@ FFFRAMEREADER_EXPORT void setLogLevel(LogLevel level) noexcept;
  */
 FFFRAMEREADER_EXPORT void log(const std::string& text, LogLevel level = LogLevel::Info) noexcept;
 
+/**
+ * Sets the maximum number of concurrently open hardware decoder sessions.
+ * @note Hardware decoder sessions (e.g. NVDEC) are a scarce per-GPU resource. When a limit is set, opening more
+ *  hardware streams than there are sessions causes the least recently used idle stream to transparently release its
+ *  session; it re-acquires one and restores its decode position the next time it is read from. This allows large
+ *  numbers of mostly idle streams to share a small pool of sessions. Streams using decode-ahead or cuvid based
+ *  cropping/scaling are excluded from session management.
+ * @param maxSessions The session limit (0 for unlimited).
+ */
+FFFRAMEREADER_EXPORT void setMaxDecodeSessions(uint32_t maxSessions) noexcept;
+
+/**
+ * Sets the pool of GPU devices used for automatic placement of hardware decoded streams.
+ * @note When a pool is configured, hardware streams that do not supply an existing context via
+ *  @DecoderOptions::m_context are placed on the least loaded device in the pool (by number of active streams)
+ *  instead of the index in @DecoderOptions::m_device. A single decoder context is created per device and shared by
+ *  all streams placed on it, so the format conversion kernels are also instantiated once per device.
+ * @param devices The device indices to use (empty to disable automatic placement).
+ */
+FFFRAMEREADER_EXPORT void setDecodeDevicePool(const std::vector<uint32_t>& devices) noexcept;
+
+/**
+ * Sets the number of worker threads used by the shared task pool for asynchronous stream operations.
+ * @note This only takes effect if called before the first asynchronous operation is submitted.
+ * @param numThreads Requested number of worker threads (0 to use the number of hardware threads).
+ */
+FFFRAMEREADER_EXPORT void setAsyncPoolSize(uint32_t numThreads) noexcept;
+
 /**
  * Gets number of planes for an image of the specified pixel format
  * @param format Describes the pixel format.
@@ -81,7 +109,7 @@ FFFRAMEREADER_EXPORT int32_t getImagePlaneStep(
     PixelFormat format, uint32_t width, uint32_t height, uint32_t plane) noexcept;
 
 /**
- * Convert pixel format using cuda.
+ * Convert pixel format. CUDA frames are converted on the GPU while host frames use vectorised CPU kernels.
  * @param       frame     The input frame.
  * @param [out] outMem    Memory location to store output (must be allocated with enough size for output frame see
  *  @getImageSize).
@@ -92,8 +120,8 @@ FFFRAMEREADER_EXPORT bool convertFormat(
     const std::shared_ptr<Frame>& frame, uint8_t* outMem, PixelFormat outFormat) noexcept;
 
 /**
- * Convert pixel format using cuda asynchronously. This requires the user to manually synchronise the cuda context using
- * @synchroniseConvert.
+ * Convert pixel format asynchronously. For CUDA frames this requires the user to manually synchronise the cuda context
+ * using @synchroniseConvert. Host frames are converted on the CPU and complete before the function returns.
  * @param       frame     The input frame.
  * @param [out] outMem    Memory location to store output (must be allocated with enough size for output frame see
  *  @getImageSize).
@@ -103,6 +131,60 @@ FFFRAMEREADER_EXPORT bool convertFormat(
 FFFRAMEREADER_EXPORT bool convertFormatAsync(
     const std::shared_ptr<Frame>& frame, uint8_t* outMem, const PixelFormat outFormat) noexcept;
 
+/**
+ * Convert the pixel format of a batch of frames. All conversions are enqueued on a single cuda stream so the
+ * per-frame launch and synchronisation overhead is amortised across the batch. All frames in the batch must use the
+ * same CUDA context. Output frames are written contiguously to @outMem, each occupying @getImageSize bytes.
+ * @param       frames    The input frames.
+ * @param [out] outMem    Memory location to store output (must be allocated with enough size for all output frames see
+ *  @getImageSize).
+ * @param       outFormat The pixel format to convert to.
+ * @returns True if it succeeds, false if it fails.
+ */
+FFFRAMEREADER_EXPORT bool convertFormatBatch(
+    const std::vector<std::shared_ptr<Frame>>& frames, uint8_t* outMem, PixelFormat outFormat) noexcept;
+
+/**
+ * Convert the pixel format of a batch of frames asynchronously on a caller supplied cuda stream. The batch is
+ * enqueued without any fence so the caller is responsible for synchronising the stream (or the cuda context using
+ * @synchroniseConvert when no stream is supplied) before reading the output.
+ * @param       frames    The input frames.
+ * @param [out] outMem    Memory location to store output (must be allocated with enough size for all output frames see
+ *  @getImageSize).
+ * @param       outFormat The pixel format to convert to.
+ * @param       stream    (Optional) The CUstream to enqueue the conversions on, or empty to use the internal stream.
+ * @returns True if it succeeds, false if it fails.
+ */
+FFFRAMEREADER_EXPORT bool convertFormatBatchAsync(const std::vector<std::shared_ptr<Frame>>& frames, uint8_t* outMem,
+    PixelFormat outFormat, const std::any& stream = std::any()) noexcept;
+
+/**
+ * Perform fused pre-processing of a CUDA frame ready for inference. Crop, bilinear scale, colour conversion and
+ * mean/std normalisation are applied in a single kernel pass, writing normalised RGB32FP data as a tightly packed
+ * planar tensor (3 x height x width floats, no line padding) directly into the supplied device memory.
+ * @param       frame  The input frame (must be an NV12 CUDA frame).
+ * @param [out] outMem Device memory location to store the output tensor (must be allocated with enough size for
+ *  3 * width * height floats at the output resolution).
+ * @param       params The crop, scale and normalisation parameters.
+ * @returns True if it succeeds, false if it fails.
+ */
+FFFRAMEREADER_EXPORT bool preProcessFrame(
+    const std::shared_ptr<Frame>& frame, uint8_t* outMem, const PreProcessParams& params) noexcept;
+
+/**
+ * Perform fused pre-processing of a CUDA frame asynchronously on a caller supplied cuda stream. The kernel is
+ * enqueued without any fence so the caller is responsible for synchronising the stream (or the cuda context using
+ * @synchroniseConvert when no stream is supplied) before reading the output.
+ * @param       frame  The input frame (must be an NV12 CUDA frame).
+ * @param [out] outMem Device memory location to store the output tensor (must be allocated with enough size for
+ *  3 * width * height floats at the output resolution).
+ * @param       params The crop, scale and normalisation parameters.
+ * @param       stream (Optional) The CUstream to enqueue the kernel on, or empty to use the internal stream.
+ * @returns True if it succeeds, false if it fails.
+ */
+FFFRAMEREADER_EXPORT bool preProcessFrameAsync(const std::shared_ptr<Frame>& frame, uint8_t* outMem,
+    const PreProcessParams& params, const std::any& stream = std::any()) noexcept;
+
 /**
  * Synchronises the internal cuda context.
  * @param stream The last stream used for cuda operations.
@@ -13,9 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "FFFRDLPack.h"
 #include "FFFREncoder.h"
 #include "FFFrameReader.h"
 
+#include <cstring>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -101,13 +104,88 @@ void bindFrameReader(pybind11::module& m)
         .def("getNumberPlanes", static_cast<int32_t (Frame::*)() const>(&Frame::getNumberPlanes),
             "Gets number of planes for an image of the specified pixel format.")
         .def("getDataType", static_cast<DecodeType (Frame::*)() const>(&Frame::getDataType),
-            "Gets the type of memory used to store the image.");
+            "Gets the type of memory used to store the image.")
+        .def(
+            "toDlpack",
+            [](const std::shared_ptr<Frame>& frame, const uint32_t plane) {
+                auto* const tensor = frame->toDLPack(plane);
+                if (tensor == nullptr) {
+                    throw pybind11::value_error("Failed to export frame plane as a DLPack tensor");
+                }
+                // Consumers rename the capsule once they take ownership, so only delete unconsumed tensors
+                return pybind11::capsule(tensor, "dltensor", [](PyObject* const capsule) {
+                    if (PyCapsule_IsValid(capsule, "dltensor") != 0) {
+                        auto* const unused = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+                        unused->deleter(unused);
+                    }
+                });
+            },
+            "Exports an image plane as a zero-copy DLPack tensor capsule. The tensor references the frame memory directly and keeps the frame alive until consumed.",
+            pybind11::arg("plane") = 0)
+        .def_property_readonly(
+            "__cuda_array_interface__",
+            [](const std::shared_ptr<Frame>& frame) {
+                if (frame->getDataType() != DecodeType::Cuda) {
+                    throw pybind11::attribute_error("Frame data is not stored in CUDA device memory");
+                }
+                auto* const tensor = frame->toDLPack(0);
+                if (tensor == nullptr) {
+                    throw pybind11::value_error("Failed to export frame as a CUDA array");
+                }
+                pybind11::dict result;
+                pybind11::tuple shape(tensor->dl_tensor.ndim);
+                pybind11::tuple strides(tensor->dl_tensor.ndim);
+                const auto elemSize = static_cast<int64_t>(tensor->dl_tensor.dtype.bits) / 8;
+                for (int32_t i = 0; i < tensor->dl_tensor.ndim; i++) {
+                    shape[i] = tensor->dl_tensor.shape[i];
+                    strides[i] = tensor->dl_tensor.strides[i] * elemSize;
+                }
+                result["shape"] = shape;
+                result["strides"] = strides;
+                result["typestr"] = tensor->dl_tensor.dtype.code == kDLFloat ? "<f4" : "|u1";
+                result["data"] =
+                    pybind11::make_tuple(reinterpret_cast<uintptr_t>(tensor->dl_tensor.data), false);
+                result["version"] = 2;
+                // The Frame object itself keeps the device memory alive while the dict is in use
+                tensor->deleter(tensor);
+                return result;
+            },
+            "Describes the frames first plane as a zero-copy CUDA array. The Frame object must be kept alive while the data is in use.")
+        .def(
+            "asArray",
+            [](const std::shared_ptr<Frame>& frame, const uint32_t plane) -> pybind11::array {
+                if (frame->getDataType() != DecodeType::Software) {
+                    throw pybind11::value_error(
+                        "Frame data is not stored in host memory, use toDlpack or __cuda_array_interface__ instead");
+                }
+                auto* const tensor = frame->toDLPack(plane);
+                if (tensor == nullptr) {
+                    throw pybind11::value_error("Failed to export frame plane as an array");
+                }
+                // The capsule keeps the frame alive for the lifetime of the returned array
+                const pybind11::capsule base(tensor, [](void* const pointer) {
+                    auto* const exported = static_cast<DLManagedTensor*>(pointer);
+                    exported->deleter(exported);
+                });
+                const auto elemSize = static_cast<ssize_t>(tensor->dl_tensor.dtype.bits) / 8;
+                std::vector<ssize_t> shape, strides;
+                for (int32_t i = 0; i < tensor->dl_tensor.ndim; i++) {
+                    shape.emplace_back(static_cast<ssize_t>(tensor->dl_tensor.shape[i]));
+                    strides.emplace_back(static_cast<ssize_t>(tensor->dl_tensor.strides[i]) * elemSize);
+                }
+                const auto type = tensor->dl_tensor.dtype.code == kDLFloat ? pybind11::dtype::of<float>() :
+                                                                             pybind11::dtype::of<uint8_t>();
+                return pybind11::array(type, shape, strides, tensor->dl_tensor.data, base);
+            },
+            "Exposes an image plane as a zero-copy numpy array referencing the frame memory directly.",
+            pybind11::arg("plane") = 0);
 
     pybind11::class_<Stream, std::shared_ptr<Stream>>(m, "Stream", "")
         .def_static("getStream",
             static_cast<std::shared_ptr<Stream> (*)(const std::string&, const DecoderOptions&)>(&Stream::getStream),
             "Gets a stream from a file.", pybind11::arg("fileName"),
-            pybind11::arg_v("options", DecoderOptions(), "DecoderOptions()"))
+            pybind11::arg_v("options", DecoderOptions(), "DecoderOptions()"),
+            pybind11::call_guard<pybind11::gil_scoped_release>())
         .def("getWidth", static_cast<uint32_t (Stream::*)() const>(&Stream::getWidth),
             "Gets the width of the video stream.")
         .def("getHeight", static_cast<uint32_t (Stream::*)() const>(&Stream::getHeight),
@@ -127,18 +205,80 @@ void bindFrameReader(pybind11::module& m)
         .def("getDecodeType", static_cast<DecodeType (Stream::*)() const>(&Stream::getDecodeType),
             "Gets the type of decoding used.")
         .def("peekNextFrame", static_cast<std::shared_ptr<Frame> (Stream::*)()>(&Stream::peekNextFrame),
-            "Get the next frame in the stream without removing it from stream buffer.")
+            "Get the next frame in the stream without removing it from stream buffer.",
+            pybind11::call_guard<pybind11::gil_scoped_release>())
         .def("getNextFrame", static_cast<std::shared_ptr<Frame> (Stream::*)()>(&Stream::getNextFrame),
-            "Gets the next frame in the stream and removes it from the buffer.")
+            "Gets the next frame in the stream and removes it from the buffer.",
+            pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("getFrames",
+            static_cast<std::vector<std::shared_ptr<Frame>> (Stream::*)(const std::vector<int64_t>&)>(
+                &Stream::getFrames),
+            "Gets a sequence of frames based on there time stamps.", pybind11::arg("frameSequence"),
+            pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("getFramesByIndex",
+            static_cast<std::vector<std::shared_ptr<Frame>> (Stream::*)(const std::vector<int64_t>&)>(
+                &Stream::getFramesByIndex),
+            "Gets a sequence of frames using frame indices.", pybind11::arg("frameSequence"),
+            pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def(
+            "getBatchByIndex",
+            [](const std::shared_ptr<Stream>& stream, const std::vector<int64_t>& frameSequence,
+                const uint32_t plane) -> pybind11::array {
+                std::vector<std::shared_ptr<Frame>> frames;
+                {
+                    // Decode without holding the GIL so other python threads can continue
+                    const pybind11::gil_scoped_release release;
+                    frames = stream->getFramesByIndex(frameSequence);
+                }
+                if (frames.empty() || frames.size() != frameSequence.size()) {
+                    throw pybind11::value_error("Failed to retrieve all of the requested frames");
+                }
+                if (frames[0]->getDataType() != DecodeType::Software) {
+                    throw pybind11::value_error("Batched retrieval requires frames stored in host memory");
+                }
+                auto* const tensor = frames[0]->toDLPack(plane);
+                if (tensor == nullptr) {
+                    throw pybind11::value_error("Failed to export frame plane as an array");
+                }
+                const auto elemSize = static_cast<ssize_t>(tensor->dl_tensor.dtype.bits) / 8;
+                std::vector<ssize_t> shape = {static_cast<ssize_t>(frames.size())};
+                ssize_t rowElems = 1;
+                for (int32_t i = 0; i < tensor->dl_tensor.ndim; i++) {
+                    shape.emplace_back(static_cast<ssize_t>(tensor->dl_tensor.shape[i]));
+                    if (i > 0) {
+                        rowElems *= static_cast<ssize_t>(tensor->dl_tensor.shape[i]);
+                    }
+                }
+                const auto numRows = static_cast<ssize_t>(tensor->dl_tensor.shape[0]);
+                tensor->deleter(tensor);
+                const auto type = frames[0]->getPixelFormat() == PixelFormat::RGB32FP ?
+                    pybind11::dtype::of<float>() :
+                    pybind11::dtype::of<uint8_t>();
+                // Stack all frames into a single preallocated contiguous array in one binding crossing
+                pybind11::array result(type, shape);
+                auto* output = static_cast<uint8_t*>(result.mutable_data());
+                const auto rowBytes = rowElems * elemSize;
+                for (const auto& frame : frames) {
+                    const auto data = frame->getFrameData(plane);
+                    for (ssize_t row = 0; row < numRows; row++) {
+                        memcpy(output, data.first + row * data.second, static_cast<size_t>(rowBytes));
+                        output += rowBytes;
+                    }
+                }
+                return result;
+            },
+            "Gets a sequence of frames using frame indices stacked into a single preallocated numpy array.",
+            pybind11::arg("frameSequence"), pybind11::arg("plane") = 0)
         .def("getMaxFrames", static_cast<uint32_t (Stream::*)()>(&Stream::getMaxFrames),
             "Gets maximum frames that can exist at a time.")
         .def("isEndOfFile", static_cast<bool (Stream::*)() const>(&Stream::isEndOfFile),
             "Query if the stream has reached end of input file.")
         .def("seek", static_cast<bool (Stream::*)(int64_t)>(&Stream::seek),
             "Seeks the stream to the given time stamp. If timestamp does not exactly match a frame hen the timestamp rounded to the nearest frame is used instead.",
-            pybind11::arg("timeStamp"))
+            pybind11::arg("timeStamp"), pybind11::call_guard<pybind11::gil_scoped_release>())
         .def("seekFrame", static_cast<bool (Stream::*)(int64_t)>(&Stream::seekFrame),
-            "Seeks the stream to the given frame number.", pybind11::arg("frame"))
+            "Seeks the stream to the given frame number.", pybind11::arg("frame"),
+            pybind11::call_guard<pybind11::gil_scoped_release>())
         .def("frameToTime", static_cast<int64_t (Stream::*)(int64_t) const>(&Stream::frameToTime),
             "Convert a zero-based frame number to time value represented in microseconds AV_TIME_BASE).",
             pybind11::arg("frame"))
@@ -184,7 +324,8 @@ void bindFrameReader(pybind11::module& m)
             static_cast<bool (*)(const std::string&, const std::shared_ptr<Stream>&, const EncoderOptions&)>(
                 &Encoder::encodeStream),
             "Encodes a stream to a file", pybind11::arg("fileName"), pybind11::arg("stream"),
-            pybind11::arg_v("options", EncoderOptions(), "EncoderOptions()"));
+            pybind11::arg_v("options", EncoderOptions(), "EncoderOptions()"),
+            pybind11::call_guard<pybind11::gil_scoped_release>());
 }
 
 PYBIND11_MODULE(pyFrameReader, m)
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "FFFRConfig.h"
+#include "FFFRDecodeScheduler.h"
+#include "FFFRGpuTransform.h"
+#include "FFFRHostConvert.h"
+#include "FFFRTaskPool.h"
 #include "FFFRUtility.h"
 #include "FFFrameReader.h"
 
@@ -50,6 +54,21 @@ void log(const std::string& text, const LogLevel level) noexcept
     av_log(nullptr, static_cast<int>(level), "%s\n", text.c_str());
 }
 
+void setMaxDecodeSessions(const uint32_t maxSessions) noexcept
+{
+    DecodeScheduler::get().setMaxSessions(maxSessions);
+}
+
+void setDecodeDevicePool(const std::vector<uint32_t>& devices) noexcept
+{
+    DecodeScheduler::get().setDevicePool(devices);
+}
+
+void setAsyncPoolSize(const uint32_t numThreads) noexcept
+{
+    TaskPool::get().setNumThreads(numThreads);
+}
+
 int32_t getPixelFormatPlanes(const PixelFormat format) noexcept
 {
     return av_pix_fmt_count_planes(getPixelFormat(format));
@@ -103,6 +122,10 @@ private:
         int m_kernelNV12ToRGB8PMem = 0;
         CUfunction m_kernelNV12ToRGB32FP = nullptr;
         int m_kernelNV12ToRGB32FPMem = 0;
+        CUfunction m_kernelPreProcessNV12ToRGB32FP = nullptr;
+        int m_kernelPreProcessNV12ToRGB32FPMem = 0;
+        CUfunction m_kernelCropScaleNV12 = nullptr;
+        int m_kernelCropScaleNV12Mem = 0;
         CUcontext m_context = nullptr;
         CUstream m_stream = nullptr;
 
@@ -139,8 +162,27 @@ private:
                 return;
             }
 
+            err = cuModuleGetFunction(&m_kernelPreProcessNV12ToRGB32FP, m_module, "preProcessNV12ToRGB32FP");
+            if (err != CUDA_SUCCESS) {
+                const char* errorString;
+                cuGetErrorName(err, &errorString);
+                logInternal(LogLevel::Error, "Failed to retrieve CUDA kernel: ", errorString);
+                return;
+            }
+
+            err = cuModuleGetFunction(&m_kernelCropScaleNV12, m_module, "cropScaleNV12");
+            if (err != CUDA_SUCCESS) {
+                const char* errorString;
+                cuGetErrorName(err, &errorString);
+                logInternal(LogLevel::Error, "Failed to retrieve CUDA kernel: ", errorString);
+                return;
+            }
+
             cuFuncGetAttribute(&m_kernelNV12ToRGB8PMem, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES, m_kernelNV12ToRGB8P);
             cuFuncGetAttribute(&m_kernelNV12ToRGB32FPMem, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES, m_kernelNV12ToRGB32FP);
+            cuFuncGetAttribute(&m_kernelPreProcessNV12ToRGB32FPMem, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES,
+                m_kernelPreProcessNV12ToRGB32FP);
+            cuFuncGetAttribute(&m_kernelCropScaleNV12Mem, CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES, m_kernelCropScaleNV12);
 
             m_context = context;
             m_stream = stream;
@@ -228,7 +270,7 @@ private:
     }
 
     static CUresult convertNV12ToRGB8P(const uint8_t* const source[2], uint32_t sourceStep, uint32_t width,
-        uint32_t height, uint8_t* dest[3], uint32_t destStep, KernelContext* context) noexcept
+        uint32_t height, uint8_t* dest[3], uint32_t destStep, KernelContext* context, const CUstream stream) noexcept
     {
         const uint32_t blockX = 8;
         const uint32_t blockY = 8;
@@ -238,11 +280,11 @@ private:
             reinterpret_cast<CUdeviceptr>(dest[2])};
         void* args[] = {&inMem, &sourceStep, &width, &height, &outMem, &destStep};
         return cuLaunchKernel(context->m_kernelNV12ToRGB8P, divUp(width, blockX), divUp(height, blockY), 1, blockX,
-            blockY, 1, context->m_kernelNV12ToRGB8PMem, context->m_stream, args, nullptr);
+            blockY, 1, context->m_kernelNV12ToRGB8PMem, stream, args, nullptr);
     }
 
     static CUresult convertNV12ToRGB32FP(const uint8_t* const source[2], uint32_t sourceStep, uint32_t width,
-        uint32_t height, uint8_t* dest[3], uint32_t destStep, KernelContext* context) noexcept
+        uint32_t height, uint8_t* dest[3], uint32_t destStep, KernelContext* context, const CUstream stream) noexcept
     {
         const uint32_t blockX = 8;
         const uint32_t blockY = 8;
@@ -252,7 +294,46 @@ private:
             reinterpret_cast<CUdeviceptr>(dest[2])};
         void* args[] = {&inMem, &sourceStep, &width, &height, &outMem, &destStep};
         return cuLaunchKernel(context->m_kernelNV12ToRGB32FP, divUp(width, blockX), divUp(height, blockY), 1, blockX,
-            blockY, 1, context->m_kernelNV12ToRGB32FPMem, context->m_stream, args, nullptr);
+            blockY, 1, context->m_kernelNV12ToRGB32FPMem, stream, args, nullptr);
+    }
+
+    static CUresult cropScaleNV12(const uint8_t* const source[2], uint32_t sourceStep, uint32_t cropLeft,
+        uint32_t cropTop, uint32_t cropWidth, uint32_t cropHeight, uint8_t* dest[2], uint32_t destStep,
+        uint32_t destWidth, uint32_t destHeight, KernelContext* context, const CUstream stream) noexcept
+    {
+        const uint32_t blockX = 8;
+        const uint32_t blockY = 8;
+
+        NV12Planes inMem = {reinterpret_cast<CUdeviceptr>(source[0]), reinterpret_cast<CUdeviceptr>(source[1])};
+        NV12Planes outMem = {reinterpret_cast<CUdeviceptr>(dest[0]), reinterpret_cast<CUdeviceptr>(dest[1])};
+        void* args[] = {&inMem, &sourceStep, &cropLeft, &cropTop, &cropWidth, &cropHeight, &outMem, &destStep,
+            &destWidth, &destHeight};
+        return cuLaunchKernel(context->m_kernelCropScaleNV12, divUp(destWidth, blockX), divUp(destHeight, blockY), 1,
+            blockX, blockY, 1, context->m_kernelCropScaleNV12Mem, stream, args, nullptr);
+    }
+
+    struct FloatRGB
+    {
+        float m_red;
+        float m_green;
+        float m_blue;
+    };
+
+    static CUresult preProcessNV12ToRGB32FP(const uint8_t* const source[2], uint32_t sourceStep, uint32_t cropLeft,
+        uint32_t cropTop, uint32_t cropWidth, uint32_t cropHeight, uint8_t* dest[3], uint32_t destWidth,
+        uint32_t destHeight, FloatRGB mean, FloatRGB invStd, KernelContext* context, const CUstream stream) noexcept
+    {
+        const uint32_t blockX = 8;
+        const uint32_t blockY = 8;
+
+        NV12Planes inMem = {reinterpret_cast<CUdeviceptr>(source[0]), reinterpret_cast<CUdeviceptr>(source[1])};
+        RGBPlanes outMem = {reinterpret_cast<CUdeviceptr>(dest[0]), reinterpret_cast<CUdeviceptr>(dest[1]),
+            reinterpret_cast<CUdeviceptr>(dest[2])};
+        void* args[] = {&inMem, &sourceStep, &cropLeft, &cropTop, &cropWidth, &cropHeight, &outMem, &destWidth,
+            &destHeight, &mean, &invStd};
+        return cuLaunchKernel(context->m_kernelPreProcessNV12ToRGB32FP, divUp(destWidth, blockX),
+            divUp(destHeight, blockY), 1, blockX, blockY, 1, context->m_kernelPreProcessNV12ToRGB32FPMem, stream, args,
+            nullptr);
     }
 
 #    if FFFR_BUILD_NPPI
@@ -406,12 +487,12 @@ public:
 #    endif
                     case PixelFormat::RGB8P: {
                         ret = convertNV12ToRGB8P(inMem, data1.second, frame->getWidth(), frame->getHeight(), outPlanes,
-                            outStep[0], kernelProps.get());
+                            outStep[0], kernelProps.get(), kernelProps->m_stream);
                         break;
                     }
                     case PixelFormat::RGB32FP: {
                         ret = convertNV12ToRGB32FP(inMem, data1.second, frame->getWidth(), frame->getHeight(),
-                            outPlanes, outStep[0], kernelProps.get());
+                            outPlanes, outStep[0], kernelProps.get(), kernelProps->m_stream);
                         break;
                     }
                     default:
@@ -497,6 +578,245 @@ public:
         return (ret == CUDA_SUCCESS);
     }
 
+    static bool convertFormatBatch(const std::vector<std::shared_ptr<Frame>>& frames, uint8_t* const outMem,
+        const PixelFormat outFormat, const bool asynch, const std::any& stream)
+    {
+        if (frames.empty() || outMem == nullptr) {
+            logInternal(LogLevel::Error, "Invalid frame");
+            return false;
+        }
+        for (const auto& frame : frames) {
+            if (frame == nullptr || frame->getDataType() != DecodeType::Cuda) {
+                logInternal(LogLevel::Error, "Only CUDA frames are currently supported by convertFormatBatch");
+                return false;
+            }
+        }
+        // All frames in a batch must come from the same cuda context so they can share a stream
+        auto* framesContext = reinterpret_cast<AVHWFramesContext*>(frames.front()->m_frame->hw_frames_ctx->data);
+        auto* cudaDevice = reinterpret_cast<AVCUDADeviceContext*>(framesContext->device_ctx->hwctx);
+        for (const auto& frame : frames) {
+            auto* checkContext = reinterpret_cast<AVHWFramesContext*>(frame->m_frame->hw_frames_ctx->data);
+            if (reinterpret_cast<AVCUDADeviceContext*>(checkContext->device_ctx->hwctx)->cuda_ctx !=
+                cudaDevice->cuda_ctx) {
+                logInternal(LogLevel::Error, "All frames in a batch must use the same CUDA context");
+                return false;
+            }
+        }
+        if (outFormat != PixelFormat::RGB8P && outFormat != PixelFormat::RGB32FP) {
+            logInternal(LogLevel::Error, "Format conversion not currently supported");
+            return false;
+        }
+        if (cuCtxPushCurrent(cudaDevice->cuda_ctx) != CUDA_SUCCESS) {
+            logInternal(LogLevel::Error, "Failed to set CUDA context");
+            return false;
+        }
+        shared_ptr<KernelContext> kernelProps;
+        {
+            lock_guard<mutex> lock(s_mutex);
+            if (!setupContext(cudaDevice->cuda_ctx, cudaDevice->stream)) {
+                return false;
+            }
+#    if FFFR_BUILD_NPPI
+            kernelProps = s_contextProperties[cudaDevice->cuda_ctx].second;
+#    else
+            kernelProps = s_contextProperties[cudaDevice->cuda_ctx];
+#    endif
+        }
+
+        // Use the caller supplied stream when one is given, otherwise the internal per-context stream
+        auto batchStream = kernelProps->m_stream;
+        if (stream.has_value()) {
+            try {
+                batchStream = any_cast<CUstream>(stream);
+            } catch (...) {
+                logInternal(LogLevel::Error, "Stream parameter must contain a valid CUstream");
+                CUcontext dummy2;
+                cuCtxPopCurrent(&dummy2);
+                return false;
+            }
+        }
+
+        // Enqueue all conversions on the one stream so the batch requires only a single fence
+        CUresult ret = CUDA_SUCCESS;
+        auto* outFrame = outMem;
+        for (const auto& frame : frames) {
+            if (frame->getPixelFormat() != PixelFormat::NV12) {
+                logInternal(LogLevel::Error, "Format conversion not currently supported");
+                ret = CUDA_ERROR_UNKNOWN;
+                break;
+            }
+            const auto width = frame->getWidth();
+            const auto height = frame->getHeight();
+            uint8_t* outPlanes[4];
+            int32_t outStep[4];
+            av_image_fill_arrays(outPlanes, outStep, outFrame, getPixelFormat(outFormat), width, height, 32);
+            const auto data1 = frame->getFrameData(0);
+            const auto data2 = frame->getFrameData(1);
+            uint8_t* const inMem[2] = {data1.first, data2.first};
+            if (outFormat == PixelFormat::RGB8P) {
+                ret = convertNV12ToRGB8P(
+                    inMem, data1.second, width, height, outPlanes, outStep[0], kernelProps.get(), batchStream);
+            } else {
+                ret = convertNV12ToRGB32FP(
+                    inMem, data1.second, width, height, outPlanes, outStep[0], kernelProps.get(), batchStream);
+            }
+            if (ret != CUDA_SUCCESS) {
+                const char* errorString;
+                cuGetErrorName(ret, &errorString);
+                logInternal(LogLevel::Error, "Format conversion failed: ", errorString);
+                break;
+            }
+            outFrame += getImageSize(outFormat, width, height);
+        }
+        if (ret == CUDA_SUCCESS && !asynch) {
+            ret = cuStreamSynchronize(batchStream);
+            if (ret != CUDA_SUCCESS) {
+                const char* errorString;
+                cuGetErrorName(ret, &errorString);
+                logInternal(LogLevel::Error, "Format conversion failed: ", errorString);
+            }
+        }
+        CUcontext dummy;
+        if (cuCtxPopCurrent(&dummy) != CUDA_SUCCESS) {
+            logInternal(LogLevel::Error, "Failed to restore CUDA context");
+        }
+        return (ret == CUDA_SUCCESS);
+    }
+
+    static bool gpuCropScaleNV12(AVFrame* const source, AVFrame* const dest, const uint32_t cropLeft,
+        const uint32_t cropTop, const uint32_t cropWidth, const uint32_t cropHeight) noexcept
+    {
+        auto* framesContext = reinterpret_cast<AVHWFramesContext*>(source->hw_frames_ctx->data);
+        auto* cudaDevice = reinterpret_cast<AVCUDADeviceContext*>(framesContext->device_ctx->hwctx);
+        if (cuCtxPushCurrent(cudaDevice->cuda_ctx) != CUDA_SUCCESS) {
+            logInternal(LogLevel::Error, "Failed to set CUDA context");
+            return false;
+        }
+        shared_ptr<KernelContext> kernelProps;
+        {
+            lock_guard<mutex> lock(s_mutex);
+            if (!setupContext(cudaDevice->cuda_ctx, cudaDevice->stream)) {
+                return false;
+            }
+#    if FFFR_BUILD_NPPI
+            kernelProps = s_contextProperties[cudaDevice->cuda_ctx].second;
+#    else
+            kernelProps = s_contextProperties[cudaDevice->cuda_ctx];
+#    endif
+        }
+
+        const uint8_t* const inMem[2] = {source->data[0], source->data[1]};
+        uint8_t* outMem[2] = {dest->data[0], dest->data[1]};
+        auto ret = cropScaleNV12(inMem, source->linesize[0], cropLeft, cropTop, cropWidth, cropHeight, outMem,
+            dest->linesize[0], dest->width, dest->height, kernelProps.get(), kernelProps->m_stream);
+        if (ret == CUDA_SUCCESS) {
+            ret = cuStreamSynchronize(kernelProps->m_stream);
+        }
+        if (ret != CUDA_SUCCESS) {
+            const char* errorString;
+            cuGetErrorName(ret, &errorString);
+            logInternal(LogLevel::Error, "GPU crop/scale failed: ", errorString);
+        }
+        CUcontext dummy;
+        if (cuCtxPopCurrent(&dummy) != CUDA_SUCCESS) {
+            logInternal(LogLevel::Error, "Failed to restore CUDA context");
+        }
+        return (ret == CUDA_SUCCESS);
+    }
+
+    static bool preProcessFrame(const std::shared_ptr<Frame>& frame, uint8_t* const outMem,
+        const PreProcessParams& params, const bool asynch, const std::any& stream) noexcept
+    {
+        if (frame == nullptr || outMem == nullptr) {
+            logInternal(LogLevel::Error, "Invalid frame");
+            return false;
+        }
+        // This only supports cuda frames
+        if (frame->getDataType() != DecodeType::Cuda) {
+            logInternal(LogLevel::Error, "Only CUDA frames are currently supported by preProcessFrame");
+            return false;
+        }
+        if (frame->getPixelFormat() != PixelFormat::NV12) {
+            logInternal(LogLevel::Error, "Format conversion not currently supported");
+            return false;
+        }
+        // Validate the crop and scale settings
+        const auto width = frame->getWidth();
+        const auto height = frame->getHeight();
+        if (params.m_crop.m_left + params.m_crop.m_right >= width ||
+            params.m_crop.m_top + params.m_crop.m_bottom >= height) {
+            logInternal(LogLevel::Error, "Crop area is larger than input frame");
+            return false;
+        }
+        const auto cropWidth = width - params.m_crop.m_left - params.m_crop.m_right;
+        const auto cropHeight = height - params.m_crop.m_top - params.m_crop.m_bottom;
+        const auto destWidth = params.m_scale.m_width != 0 ? params.m_scale.m_width : cropWidth;
+        const auto destHeight = params.m_scale.m_height != 0 ? params.m_scale.m_height : cropHeight;
+        if (params.m_std[0] == 0.0f || params.m_std[1] == 0.0f || params.m_std[2] == 0.0f) {
+            logInternal(LogLevel::Error, "Standard deviation values must be non-zero");
+            return false;
+        }
+        auto* framesContext = reinterpret_cast<AVHWFramesContext*>(frame->m_frame->hw_frames_ctx->data);
+        auto* cudaDevice = reinterpret_cast<AVCUDADeviceContext*>(framesContext->device_ctx->hwctx);
+        if (cuCtxPushCurrent(cudaDevice->cuda_ctx) != CUDA_SUCCESS) {
+            logInternal(LogLevel::Error, "Failed to set CUDA context");
+            return false;
+        }
+        shared_ptr<KernelContext> kernelProps;
+        {
+            lock_guard<mutex> lock(s_mutex);
+            if (!setupContext(cudaDevice->cuda_ctx, cudaDevice->stream)) {
+                return false;
+            }
+#    if FFFR_BUILD_NPPI
+            kernelProps = s_contextProperties[cudaDevice->cuda_ctx].second;
+#    else
+            kernelProps = s_contextProperties[cudaDevice->cuda_ctx];
+#    endif
+        }
+
+        auto preProcessStream = kernelProps->m_stream;
+        if (stream.has_value()) {
+            try {
+                preProcessStream = any_cast<CUstream>(stream);
+            } catch (...) {
+                logInternal(LogLevel::Error, "Stream parameter must contain a valid CUstream");
+                CUcontext dummy2;
+                cuCtxPopCurrent(&dummy2);
+                return false;
+            }
+        }
+
+        // The output is written as a tightly packed planar tensor suitable for direct use in inference
+        const auto planeSize = static_cast<size_t>(destWidth) * destHeight * sizeof(float);
+        uint8_t* outPlanes[3] = {outMem, outMem + planeSize, outMem + 2 * planeSize};
+        const auto data1 = frame->getFrameData(0);
+        const auto data2 = frame->getFrameData(1);
+        uint8_t* const inMem[2] = {data1.first, data2.first};
+        const FloatRGB mean = {params.m_mean[0], params.m_mean[1], params.m_mean[2]};
+        const FloatRGB invStd = {1.0f / params.m_std[0], 1.0f / params.m_std[1], 1.0f / params.m_std[2]};
+        auto ret = preProcessNV12ToRGB32FP(inMem, data1.second, params.m_crop.m_left, params.m_crop.m_top, cropWidth,
+            cropHeight, outPlanes, destWidth, destHeight, mean, invStd, kernelProps.get(), preProcessStream);
+        if (ret != CUDA_SUCCESS) {
+            const char* errorString;
+            cuGetErrorName(ret, &errorString);
+            logInternal(LogLevel::Error, "Frame pre-processing failed: ", errorString);
+        }
+        if (ret == CUDA_SUCCESS && !asynch) {
+            ret = cuStreamSynchronize(preProcessStream);
+            if (ret != CUDA_SUCCESS) {
+                const char* errorString;
+                cuGetErrorName(ret, &errorString);
+                logInternal(LogLevel::Error, "Frame pre-processing failed: ", errorString);
+            }
+        }
+        CUcontext dummy;
+        if (cuCtxPopCurrent(&dummy) != CUDA_SUCCESS) {
+            logInternal(LogLevel::Error, "Failed to restore CUDA context");
+        }
+        return (ret == CUDA_SUCCESS);
+    }
+
     static bool synchroniseConvert(const std::shared_ptr<Stream>& stream) noexcept
     {
         if (stream == nullptr || stream->m_codecContext->pix_fmt != AV_PIX_FMT_CUDA || stream->m_outputHost) {
@@ -536,6 +856,9 @@ public:
 
 bool convertFormat(const std::shared_ptr<Frame>& frame, uint8_t* outMem, const PixelFormat outFormat) noexcept
 {
+    if (frame != nullptr && frame->getDataType() == DecodeType::Software) {
+        return hostConvertFormat(frame, outMem, outFormat);
+    }
 #if FFFR_BUILD_CUDA
     return FFR::convertFormat(frame, outMem, outFormat, false);
 #else
@@ -548,6 +871,10 @@ bool convertFormat(const std::shared_ptr<Frame>& frame, uint8_t* outMem, const P
 
 bool convertFormatAsync(const std::shared_ptr<Frame>& frame, uint8_t* outMem, const PixelFormat outFormat) noexcept
 {
+    if (frame != nullptr && frame->getDataType() == DecodeType::Software) {
+        // Host conversions complete synchronously
+        return hostConvertFormat(frame, outMem, outFormat);
+    }
 #if FFFR_BUILD_CUDA
     return FFR::convertFormat(frame, outMem, outFormat, true);
 #else
@@ -558,6 +885,96 @@ bool convertFormatAsync(const std::shared_ptr<Frame>& frame, uint8_t* outMem, co
 #endif
 }
 
+bool convertFormatBatch(
+    const std::vector<std::shared_ptr<Frame>>& frames, uint8_t* outMem, const PixelFormat outFormat) noexcept
+{
+    if (!frames.empty() && frames.front() != nullptr && frames.front()->getDataType() == DecodeType::Software) {
+        auto* outFrame = outMem;
+        for (const auto& frame : frames) {
+            if (!hostConvertFormat(frame, outFrame, outFormat)) {
+                return false;
+            }
+            outFrame += getImageSize(outFormat, frame->getWidth(), frame->getHeight());
+        }
+        return true;
+    }
+#if FFFR_BUILD_CUDA
+    return FFR::convertFormatBatch(frames, outMem, outFormat, false, std::any());
+#else
+    (void)(frames);
+    (void)(outMem);
+    (void)(outFormat);
+    return false;
+#endif
+}
+
+bool convertFormatBatchAsync(const std::vector<std::shared_ptr<Frame>>& frames, uint8_t* outMem,
+    const PixelFormat outFormat, const std::any& stream) noexcept
+{
+    if (!frames.empty() && frames.front() != nullptr && frames.front()->getDataType() == DecodeType::Software) {
+        // Host conversions complete synchronously
+        auto* outFrame = outMem;
+        for (const auto& frame : frames) {
+            if (!hostConvertFormat(frame, outFrame, outFormat)) {
+                return false;
+            }
+            outFrame += getImageSize(outFormat, frame->getWidth(), frame->getHeight());
+        }
+        return true;
+    }
+#if FFFR_BUILD_CUDA
+    return FFR::convertFormatBatch(frames, outMem, outFormat, true, stream);
+#else
+    (void)(frames);
+    (void)(outMem);
+    (void)(outFormat);
+    (void)(stream);
+    return false;
+#endif
+}
+
+bool gpuCropScaleNV12(AVFrame* source, AVFrame* dest, const uint32_t cropLeft, const uint32_t cropTop,
+    const uint32_t cropWidth, const uint32_t cropHeight) noexcept
+{
+#if FFFR_BUILD_CUDA
+    return FFR::gpuCropScaleNV12(source, dest, cropLeft, cropTop, cropWidth, cropHeight);
+#else
+    (void)(source);
+    (void)(dest);
+    (void)(cropLeft);
+    (void)(cropTop);
+    (void)(cropWidth);
+    (void)(cropHeight);
+    return false;
+#endif
+}
+
+bool preProcessFrame(const std::shared_ptr<Frame>& frame, uint8_t* outMem, const PreProcessParams& params) noexcept
+{
+#if FFFR_BUILD_CUDA
+    return FFR::preProcessFrame(frame, outMem, params, false, std::any());
+#else
+    (void)(frame);
+    (void)(outMem);
+    (void)(params);
+    return false;
+#endif
+}
+
+bool preProcessFrameAsync(const std::shared_ptr<Frame>& frame, uint8_t* outMem, const PreProcessParams& params,
+    const std::any& stream) noexcept
+{
+#if FFFR_BUILD_CUDA
+    return FFR::preProcessFrame(frame, outMem, params, true, stream);
+#else
+    (void)(frame);
+    (void)(outMem);
+    (void)(params);
+    (void)(stream);
+    return false;
+#endif
+}
+
 bool synchroniseConvert(const std::shared_ptr<Stream>& stream) noexcept
 {
 #if FFFR_BUILD_CUDA
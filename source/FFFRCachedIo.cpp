@@ -0,0 +1,172 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRCachedIo.h"
+
+#include "FFFRUtility.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavformat/avio.h>
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+using namespace std;
+
+namespace Ffr {
+CachedIo::CachedIo(const std::string& fileName) noexcept
+{
+    auto ret = avio_open(&m_inner, fileName.c_str(), AVIO_FLAG_READ);
+    if (ret < 0) {
+        logInternal(LogLevel::Error, "Failed to open input for cached I/O: ", fileName, ", ", getFfmpegErrorString(ret));
+        return;
+    }
+    m_size = avio_size(m_inner);
+    if (m_size < 0) {
+        // The cache requires a known size to detect the end of the source
+        logInternal(LogLevel::Warning, "Input size unavailable, cached I/O cannot be used: ", fileName);
+        avio_closep(&m_inner);
+        return;
+    }
+
+    constexpr uint32_t bufferSize = 32768;
+    auto* const buffer = static_cast<uint8_t*>(av_malloc(bufferSize));
+    if (buffer == nullptr) {
+        logInternal(LogLevel::Error, "Failed to allocate I/O context buffer");
+        avio_closep(&m_inner);
+        return;
+    }
+    m_context = avio_alloc_context(buffer, bufferSize, 0, this, &CachedIo::readPacket, nullptr, &CachedIo::seekIo);
+    if (m_context == nullptr) {
+        logInternal(LogLevel::Error, "Failed to allocate cached I/O context");
+        av_free(buffer);
+        avio_closep(&m_inner);
+    }
+}
+
+CachedIo::~CachedIo() noexcept
+{
+    if (m_context != nullptr) {
+        av_free(m_context->buffer);
+        avio_context_free(&m_context);
+    }
+    if (m_inner != nullptr) {
+        avio_closep(&m_inner);
+    }
+}
+
+bool CachedIo::isValid() const noexcept
+{
+    return m_context != nullptr;
+}
+
+AVIOContext* CachedIo::getContext() const noexcept
+{
+    return m_context;
+}
+
+const CachedIo::Block* CachedIo::getBlock(const int64_t index) noexcept
+{
+    const auto found = m_lookup.find(index);
+    if (found != m_lookup.end()) {
+        // Move the block to the front of the LRU list
+        m_blocks.splice(m_blocks.begin(), m_blocks, found->second);
+        return &m_blocks.front();
+    }
+    // Fetch the block from the source using a single large ranged read
+    const auto start = index * static_cast<int64_t>(m_blockSize);
+    const auto length = static_cast<uint32_t>(std::min(static_cast<int64_t>(m_blockSize), m_size - start));
+    if (avio_seek(m_inner, start, SEEK_SET) < 0) {
+        logInternal(LogLevel::Error, "Failed to seek input for cached I/O block: ", index);
+        return nullptr;
+    }
+    try {
+        Block block = {index, vector<uint8_t>(length)};
+        uint32_t total = 0;
+        while (total < length) {
+            const auto read = avio_read(m_inner, block.m_data.data() + total, static_cast<int32_t>(length - total));
+            if (read <= 0) {
+                logInternal(LogLevel::Error, "Failed to read input for cached I/O block: ", index);
+                return nullptr;
+            }
+            total += static_cast<uint32_t>(read);
+        }
+        m_blocks.emplace_front(move(block));
+        m_lookup[index] = m_blocks.begin();
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to allocate cached I/O block");
+        return nullptr;
+    }
+    // Evict the least recently used block once the cache is full
+    if (m_blocks.size() > m_maxBlocks) {
+        m_lookup.erase(m_blocks.back().m_index);
+        m_blocks.pop_back();
+    }
+    return &m_blocks.front();
+}
+
+int32_t CachedIo::readPacket(void* const opaque, uint8_t* const buffer, const int32_t size) noexcept
+{
+    auto* const io = static_cast<CachedIo*>(opaque);
+    if (io->m_position >= io->m_size) {
+        return AVERROR_EOF;
+    }
+    int32_t total = 0;
+    while (total < size && io->m_position < io->m_size) {
+        const auto index = io->m_position / m_blockSize;
+        const auto* const block = io->getBlock(index);
+        if (block == nullptr) {
+            return total != 0 ? total : AVERROR(EIO);
+        }
+        const auto offset = static_cast<size_t>(io->m_position - index * static_cast<int64_t>(m_blockSize));
+        const auto copy = std::min(static_cast<size_t>(size - total), block->m_data.size() - offset);
+        memcpy(buffer + total, block->m_data.data() + offset, copy);
+        total += static_cast<int32_t>(copy);
+        io->m_position += static_cast<int64_t>(copy);
+    }
+    return total;
+}
+
+int64_t CachedIo::seekIo(void* const opaque, const int64_t offset, const int32_t whence) noexcept
+{
+    auto* const io = static_cast<CachedIo*>(opaque);
+    if ((whence & AVSEEK_SIZE) != 0) {
+        return io->m_size;
+    }
+    int64_t position;
+    switch (whence & ~AVSEEK_FORCE) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position = io->m_position + offset;
+            break;
+        case SEEK_END:
+            position = io->m_size + offset;
+            break;
+        default:
+            return AVERROR(EINVAL);
+    }
+    if (position < 0 || position > io->m_size) {
+        return AVERROR(EINVAL);
+    }
+    // Only the logical position moves, the source is not touched until an uncached block is read
+    io->m_position = position;
+    return position;
+}
+} // namespace Ffr
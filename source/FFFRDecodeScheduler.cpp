@@ -0,0 +1,148 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRDecodeScheduler.h"
+
+#include "FFFRDecoderContext.h"
+#include "FFFRStream.h"
+#include "FFFRUtility.h"
+#include "FFFrameReader.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+namespace Ffr {
+DecodeScheduler& DecodeScheduler::get() noexcept
+{
+    static DecodeScheduler scheduler;
+    return scheduler;
+}
+
+void DecodeScheduler::setMaxSessions(const uint32_t maxSessions) noexcept
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_maxSessions = maxSessions;
+}
+
+void DecodeScheduler::setDevicePool(const std::vector<uint32_t>& devices) noexcept
+{
+    try {
+        lock_guard<mutex> lock(m_mutex);
+        m_devicePool = devices;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to set decode device pool");
+    }
+}
+
+std::shared_ptr<DecoderContext> DecodeScheduler::acquireDevice(const DecodeType type, uint32_t& device) noexcept
+{
+    try {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_devicePool.empty()) {
+            return nullptr;
+        }
+        // Pick the least loaded device in the pool
+        uint32_t bestDevice = m_devicePool.front();
+        uint32_t bestLoad = UINT32_MAX;
+        for (const auto& i : m_devicePool) {
+            const auto load = m_deviceLoad[i];
+            if (load < bestLoad) {
+                bestLoad = load;
+                bestDevice = i;
+            }
+        }
+        // Lazily create a single context per device that is shared by all streams placed on it
+        auto& context = m_deviceContexts[bestDevice];
+        if (context == nullptr) {
+            context = make_shared<DecoderContext>(type, any(), bestDevice);
+            if (context->m_deviceContext.get() == nullptr) {
+                m_deviceContexts.erase(bestDevice);
+                logInternal(LogLevel::Error, "Failed to create decoder context for pooled device: ", bestDevice);
+                return nullptr;
+            }
+        }
+        ++m_deviceLoad[bestDevice];
+        device = bestDevice;
+        return context;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to place stream on pooled device");
+        return nullptr;
+    }
+}
+
+void DecodeScheduler::releaseDevice(const uint32_t device) noexcept
+{
+    lock_guard<mutex> lock(m_mutex);
+    const auto pos = m_deviceLoad.find(device);
+    if (pos != m_deviceLoad.end() && pos->second != 0) {
+        --pos->second;
+    }
+}
+
+bool DecodeScheduler::acquireSession(Stream* const stream) noexcept
+{
+    try {
+        unique_lock<mutex> lock(m_mutex);
+        while (m_maxSessions != 0 && m_sessions.size() >= m_maxSessions) {
+            // Try to suspend the least recently used idle stream to free up a session. Streams that are currently
+            // decoding hold their mutex so fail the try_lock and are skipped
+            bool suspended = false;
+            for (auto i = m_sessions.begin(); i != m_sessions.end(); ++i) {
+                Stream* const victim = *i;
+                if (victim->m_mutex.try_lock()) {
+                    const bool released = victim->suspendDecoderSession();
+                    victim->m_mutex.unlock();
+                    if (released) {
+                        m_sessions.erase(i);
+                        suspended = true;
+                        break;
+                    }
+                }
+            }
+            if (suspended) {
+                break;
+            }
+            // All session holders are busy, wait for one to become idle and retry
+            m_condition.wait_for(lock, 10ms);
+        }
+        m_sessions.emplace_back(stream);
+        return true;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to acquire hardware decoder session");
+        return false;
+    }
+}
+
+void DecodeScheduler::releaseSession(Stream* const stream) noexcept
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_sessions.remove(stream);
+    }
+    m_condition.notify_all();
+}
+
+void DecodeScheduler::touchSession(Stream* const stream) noexcept
+{
+    lock_guard<mutex> lock(m_mutex);
+    const auto pos = find(m_sessions.begin(), m_sessions.end(), stream);
+    if (pos != m_sessions.end()) {
+        // Move to the back so the least recently used streams stay at the front
+        m_sessions.splice(m_sessions.end(), m_sessions, pos);
+    }
+}
+} // namespace Ffr
@@ -21,6 +21,12 @@
 #include "FFFrameReader.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 extern "C" {
 #include <libavfilter/avfilter.h>
@@ -34,10 +40,12 @@ namespace Ffr {
 AVCodecID getCodecID(const EncodeType encoder) noexcept
 {
     switch (encoder) {
-        case EncodeType::h264: {
+        case EncodeType::h264:
+        case EncodeType::h264_nvenc: {
             return AV_CODEC_ID_H264;
         }
-        case EncodeType::h265: {
+        case EncodeType::h265:
+        case EncodeType::h265_nvenc: {
             return AV_CODEC_ID_H265;
         }
         default: {
@@ -46,6 +54,11 @@ AVCodecID getCodecID(const EncodeType encoder) noexcept
     }
 }
 
+static bool isNvencEncoder(const EncodeType encoder) noexcept
+{
+    return encoder == EncodeType::h264_nvenc || encoder == EncodeType::h265_nvenc;
+}
+
 string getPresetString(const EncoderOptions::Preset preset) noexcept
 {
     switch (preset) {
@@ -85,9 +98,48 @@ string getPresetString(const EncoderOptions::Preset preset) noexcept
     }
 }
 
+static string getPresetStringNvenc(const EncoderOptions::Preset preset) noexcept
+{
+    // NVENC only exposes fast/medium/slow style presets so the finer grained x264 values are collapsed
+    switch (preset) {
+        case EncoderOptions::Preset::Ultrafast:
+        case EncoderOptions::Preset::Superfast:
+        case EncoderOptions::Preset::Veryfast:
+        case EncoderOptions::Preset::Faster:
+        case EncoderOptions::Preset::Fast: {
+            return "fast";
+        }
+        case EncoderOptions::Preset::Medium: {
+            return "medium";
+        }
+        case EncoderOptions::Preset::Slow:
+        case EncoderOptions::Preset::Slower:
+        case EncoderOptions::Preset::Veryslow:
+        case EncoderOptions::Preset::Placebo: {
+            return "slow";
+        }
+        default: {
+            return "medium";
+        }
+    }
+}
+
 bool Encoder::encodeStream(
     const std::string& fileName, const std::shared_ptr<Stream>& stream, const EncoderOptions& options) noexcept
 {
+    if (options.m_segments > 1) {
+        return encodeStreamSegmented(fileName, stream, options);
+    }
+    // When using NVENC on a device-output stream the encoder accepts the CUDA frames directly
+    AVBufferRef* hwFramesContext = nullptr;
+    if (isNvencEncoder(options.m_type) && !stream->m_outputHost) {
+        // Ensure the decoder has created its hardware frames context
+        if (stream->peekNextFrame() == nullptr) {
+            return false;
+        }
+        hwFramesContext = stream->m_gpuFramesContext != nullptr ? stream->m_gpuFramesContext :
+                                                                  stream->m_codecContext->hw_frames_ctx;
+    }
     // Create the new encoder
     const shared_ptr<Encoder> encoder = make_shared<Encoder>(fileName, stream->getWidth(), stream->getHeight(),
         getRational(StreamUtils::getSampleAspectRatio(stream.get())), stream->getPixelFormat(),
@@ -95,19 +147,22 @@ bool Encoder::encodeStream(
         stream->getDuration() -
             (stream->m_lastDecodedTimeStamp != INT64_MIN ? stream->timeStampToTime2(stream->m_lastDecodedTimeStamp) :
                                                            0),
-        options.m_type, options.m_quality, options.m_preset, options.m_numThreads, options.m_gopSize,
+        options.m_type, options.m_quality, options.m_preset, options.m_numThreads, options.m_gopSize, hwFramesContext,
         ConstructorLock());
     if (!encoder->isEncoderValid()) {
         // Encoder creation failed
         return false;
     }
+    if (options.m_pipelined) {
+        return encoder->encodeStreamPipelined(stream);
+    }
     return encoder->encodeStream(stream);
 }
 
 Encoder::Encoder(const std::string& fileName, const uint32_t width, const uint32_t height, const Rational aspect,
     const PixelFormat format, const Rational frameRate, const int64_t duration, const EncodeType codecType,
     const uint8_t quality, const EncoderOptions::Preset preset, const uint32_t numThreads, const uint32_t gopSize,
-    ConstructorLock) noexcept
+    AVBufferRef* const hwFramesContext, ConstructorLock) noexcept
 {
     AVFormatContext* formatPtr = nullptr;
     auto ret = avformat_alloc_output_context2(&formatPtr, nullptr, nullptr, fileName.c_str());
@@ -123,7 +178,12 @@ Encoder::Encoder(const std::string& fileName, const uint32_t width, const uint32
     }
 
     // Find the required encoder
-    const AVCodec* const encoder = avcodec_find_encoder(getCodecID(codecType));
+    const AVCodec* encoder;
+    if (isNvencEncoder(codecType)) {
+        encoder = avcodec_find_encoder_by_name(codecType == EncodeType::h264_nvenc ? "h264_nvenc" : "hevc_nvenc");
+    } else {
+        encoder = avcodec_find_encoder(getCodecID(codecType));
+    }
     if (!encoder) {
         logInternal(LogLevel::Error, "Requested encoder is not supported");
         return;
@@ -138,7 +198,17 @@ Encoder::Encoder(const std::string& fileName, const uint32_t width, const uint32
     tempCodec->height = height;
     tempCodec->width = width;
     tempCodec->sample_aspect_ratio = {aspect.m_numerator, aspect.m_denominator};
-    tempCodec->pix_fmt = getPixelFormat(format);
+    if (hwFramesContext != nullptr) {
+        // Encode device frames directly so nothing is downloaded across PCIe
+        tempCodec->hw_frames_ctx = av_buffer_ref(hwFramesContext);
+        if (tempCodec->hw_frames_ctx == nullptr) {
+            logInternal(LogLevel::Error, "Failed to reference hardware frames context");
+            return;
+        }
+        tempCodec->pix_fmt = AV_PIX_FMT_CUDA;
+    } else {
+        tempCodec->pix_fmt = getPixelFormat(format);
+    }
     tempCodec->framerate = {frameRate.m_numerator, frameRate.m_denominator};
     tempCodec->time_base = av_inv_q(tempCodec->framerate);
     av_opt_set_int(tempCodec.get(), "refcounted_frames", 1, 0);
@@ -154,8 +224,15 @@ Encoder::Encoder(const std::string& fileName, const uint32_t width, const uint32
     // x264 allows crf from 0->51 where 23 is default
     // x265 allows crf from 0->51 where 28 is default and should correspond to 23 in x264
     // vp9 allows crf from 0->63 where 31 is default
-    av_dict_set(&opts, "crf", to_string(encoderCRF).c_str(), 0);
-    av_dict_set(&opts, "preset", getPresetString(preset).c_str(), 0);
+    if (isNvencEncoder(codecType)) {
+        // NVENC uses constant quality rate control in place of crf
+        av_dict_set(&opts, "rc", "vbr", 0);
+        av_dict_set(&opts, "cq", to_string(encoderCRF).c_str(), 0);
+        av_dict_set(&opts, "preset", getPresetStringNvenc(preset).c_str(), 0);
+    } else {
+        av_dict_set(&opts, "crf", to_string(encoderCRF).c_str(), 0);
+        av_dict_set(&opts, "preset", getPresetString(preset).c_str(), 0);
+    }
 
     if (numThreads != 0) {
         av_dict_set(&opts, "threads", to_string(numThreads).c_str(), 0);
@@ -243,6 +320,266 @@ bool Encoder::encodeStream(const std::shared_ptr<Stream>& stream) const noexcept
     }
 }
 
+bool Encoder::encodeStreamPipelined(const std::shared_ptr<Stream>& stream) const noexcept
+{
+    try {
+        // Decode on a worker thread and encode/mux on this thread, connected by a bounded frame queue so the two
+        // stages overlap instead of strictly alternating
+        constexpr size_t queueLimit = 8;
+        deque<shared_ptr<Frame>> queue;
+        mutex queueMutex;
+        condition_variable queueCondition;
+        bool encodeFailed = false;
+
+        thread decodeWorker([&]() {
+            while (true) {
+                auto frame = stream->getNextFrame();
+                const bool endOfStream = frame == nullptr;
+                {
+                    unique_lock<mutex> lock(queueMutex);
+                    queueCondition.wait(lock, [&]() { return queue.size() < queueLimit || encodeFailed; });
+                    if (encodeFailed) {
+                        break;
+                    }
+                    queue.emplace_back(move(frame));
+                }
+                queueCondition.notify_all();
+                if (endOfStream) {
+                    break;
+                }
+            }
+        });
+
+        bool ret = true;
+        while (true) {
+            shared_ptr<Frame> frame;
+            {
+                unique_lock<mutex> lock(queueMutex);
+                queueCondition.wait(lock, [&]() { return !queue.empty(); });
+                frame = move(queue.front());
+                queue.pop_front();
+            }
+            queueCondition.notify_all();
+            if (frame == nullptr) {
+                // Either the input finished or decoding failed mid-stream
+                if (!stream->isEndOfFile()) {
+                    ret = false;
+                    break;
+                }
+                ret = encodeFrame(nullptr, stream);
+                break;
+            }
+            if (!encodeFrame(frame, stream)) {
+                ret = false;
+                break;
+            }
+        }
+
+        // Release the decode worker should it be blocked on a full queue
+        {
+            lock_guard<mutex> lock(queueMutex);
+            encodeFailed = !ret;
+        }
+        queueCondition.notify_all();
+        decodeWorker.join();
+        return ret;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create pipelined encode stages");
+        return false;
+    }
+}
+
+bool Encoder::encodeStreamSegmented(
+    const std::string& fileName, const std::shared_ptr<Stream>& stream, const EncoderOptions& options) noexcept
+{
+    try {
+        const auto totalFrames = stream->getTotalFrames();
+        const auto numSegments = min(static_cast<int64_t>(options.m_segments), totalFrames);
+        if (numSegments <= 1) {
+            auto segmentOptions = options;
+            segmentOptions.m_segments = 0;
+            return encodeStream(fileName, stream, segmentOptions);
+        }
+        const int64_t framesPerSegment = (totalFrames + numSegments - 1) / numSegments;
+
+        // Each worker re-opens the source so it owns an independent decoder and encodes its frame range to a
+        // temporary file next to the final output
+        vector<string> segmentFiles;
+        for (int64_t i = 0; i < numSegments; i++) {
+            segmentFiles.emplace_back((fileName + ".seg"s) += to_string(i));
+        }
+        vector<uint8_t> results(static_cast<size_t>(numSegments), 0);
+        vector<thread> workers;
+        for (int64_t i = 0; i < numSegments; i++) {
+            workers.emplace_back([&, i]() {
+                // Re-open with the same options so segment output matches the callers stream (crop/scale/format etc.)
+                const auto segmentStream = Stream::getStream(stream->m_fileName, stream->m_openOptions);
+                if (segmentStream == nullptr) {
+                    return;
+                }
+                const int64_t startFrame = i * framesPerSegment;
+                if (startFrame != 0 && !segmentStream->seekFrame(startFrame)) {
+                    return;
+                }
+                const auto numFrames = min(framesPerSegment, totalFrames - startFrame);
+                const auto frameRate = StreamUtils::getFrameRate(segmentStream.get());
+                const auto duration = av_rescale_q(numFrames, av_inv_q(frameRate), {1, AV_TIME_BASE});
+                const auto encoder = make_shared<Encoder>(segmentFiles[static_cast<size_t>(i)],
+                    segmentStream->getWidth(), segmentStream->getHeight(),
+                    getRational(StreamUtils::getSampleAspectRatio(segmentStream.get())),
+                    segmentStream->getPixelFormat(), getRational(frameRate), duration, options.m_type,
+                    options.m_quality, options.m_preset, options.m_numThreads, options.m_gopSize, nullptr,
+                    ConstructorLock());
+                if (!encoder->isEncoderValid()) {
+                    return;
+                }
+                if (encoder->encodeFrames(segmentStream, numFrames)) {
+                    results[static_cast<size_t>(i)] = 1;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        bool ret = find(results.begin(), results.end(), 0) == results.end();
+        if (ret) {
+            ret = concatenateSegments(fileName, segmentFiles);
+        } else {
+            logInternal(LogLevel::Error, "Failed to encode one or more segments of: ", fileName);
+        }
+        for (const auto& segmentFile : segmentFiles) {
+            remove(segmentFile.c_str());
+        }
+        return ret;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create segmented encode workers");
+        return false;
+    }
+}
+
+bool Encoder::encodeFrames(const std::shared_ptr<Stream>& stream, const int64_t numFrames) const noexcept
+{
+    for (int64_t i = 0; i < numFrames; i++) {
+        // Get next frame
+        auto frame = stream->getNextFrame();
+        if (frame == nullptr) {
+            if (!stream->isEndOfFile()) {
+                return false;
+            }
+            break;
+        }
+        if (!encodeFrame(frame, stream)) {
+            return false;
+        }
+    }
+    // Flush the encoder and write the file trailer
+    return encodeFrame(nullptr, stream);
+}
+
+bool Encoder::concatenateSegments(const std::string& fileName, const std::vector<std::string>& segmentFiles) noexcept
+{
+    AVFormatContext* formatPtr = nullptr;
+    auto ret = avformat_alloc_output_context2(&formatPtr, nullptr, nullptr, fileName.c_str());
+    OutputFormatContextPtr outputFormat(formatPtr);
+    if (ret < 0) {
+        logInternal(LogLevel::Error, "Failed to open output stream ", getFfmpegErrorString(ret));
+        return false;
+    }
+    const auto outStream = avformat_new_stream(outputFormat.get(), nullptr);
+    if (outStream == nullptr) {
+        logInternal(LogLevel::Error, "Failed to create an output stream");
+        return false;
+    }
+
+    bool wroteHeader = false;
+    for (const auto& segmentFile : segmentFiles) {
+        AVFormatContext* inputPtr = nullptr;
+        ret = avformat_open_input(&inputPtr, segmentFile.c_str(), nullptr, nullptr);
+        FormatContextPtr inputFormat(inputPtr);
+        if (ret < 0) {
+            logInternal(LogLevel::Error, "Failed to open segment file: ", segmentFile, ", ", getFfmpegErrorString(ret));
+            return false;
+        }
+        ret = avformat_find_stream_info(inputFormat.get(), nullptr);
+        if (ret < 0) {
+            logInternal(
+                LogLevel::Error, "Failed finding stream information: ", segmentFile, ", ", getFfmpegErrorString(ret));
+            return false;
+        }
+        const auto inStream = inputFormat->streams[0];
+        if (!wroteHeader) {
+            // Copy the stream parameters from the first segment
+            ret = avcodec_parameters_copy(outStream->codecpar, inStream->codecpar);
+            if (ret < 0) {
+                logInternal(
+                    LogLevel::Error, "Failed copying parameters to output stream: ", getFfmpegErrorString(ret));
+                return false;
+            }
+            outStream->codecpar->codec_tag = 0;
+            outStream->time_base = inStream->time_base;
+            outStream->r_frame_rate = inStream->r_frame_rate;
+            outStream->avg_frame_rate = inStream->avg_frame_rate;
+            if (!(outputFormat->oformat->flags & AVFMT_NOFILE)) {
+                ret = avio_open(&outputFormat->pb, fileName.c_str(), AVIO_FLAG_WRITE);
+                if (ret < 0) {
+                    logInternal(
+                        LogLevel::Error, "Failed to open output file: ", fileName, ", ", getFfmpegErrorString(ret));
+                    return false;
+                }
+            }
+            ret = avformat_write_header(outputFormat.get(), nullptr);
+            if (ret < 0) {
+                logInternal(LogLevel::Error, "Failed writing header to output file: ", fileName, ", ",
+                    getFfmpegErrorString(ret));
+                return false;
+            }
+            wroteHeader = true;
+        }
+
+        // Stream copy all the packets. The segments carry absolute source timestamps so they can be passed through
+        // without any offsetting
+        AVPacket packet;
+        while (true) {
+            packet.data = nullptr;
+            packet.size = 0;
+            av_init_packet(&packet);
+            ret = av_read_frame(inputFormat.get(), &packet);
+            if (ret < 0) {
+                av_packet_unref(&packet);
+                if (ret == AVERROR_EOF) {
+                    break;
+                }
+                logInternal(
+                    LogLevel::Error, "Failed to read segment file: ", segmentFile, ", ", getFfmpegErrorString(ret));
+                return false;
+            }
+            if (packet.stream_index != 0) {
+                av_packet_unref(&packet);
+                continue;
+            }
+            av_packet_rescale_ts(&packet, inStream->time_base, outStream->time_base);
+            packet.stream_index = 0;
+            packet.pos = -1;
+            ret = av_interleaved_write_frame(outputFormat.get(), &packet);
+            if (ret < 0) {
+                av_packet_unref(&packet);
+                logInternal(LogLevel::Error, "Failed to write segment frame: ", getFfmpegErrorString(ret));
+                return false;
+            }
+            av_packet_unref(&packet);
+        }
+    }
+
+    av_interleaved_write_frame(outputFormat.get(), nullptr);
+    ret = av_write_trailer(outputFormat.get());
+    if (ret < 0) {
+        logInternal(LogLevel::Error, "Failed to write file trailer: ", getFfmpegErrorString(ret));
+        return false;
+    }
+    return true;
+}
+
 bool Encoder::encodeFrame(const std::shared_ptr<Frame>& frame, const std::shared_ptr<Stream>& stream) const noexcept
 {
     if (frame != nullptr) {
@@ -246,6 +246,32 @@ bool Filter::receiveFrame(FramePtr& frame) const noexcept
     return true;
 }
 
+bool Filter::sendReceiveFrames(const std::vector<FramePtr*>& frames) const noexcept
+{
+    // Submit the complete block before draining so frame-threaded filters can work on multiple frames at once
+    for (auto* const frame : frames) {
+        LOG_DEBUG("sendReceiveFrames- Sending frame to filter graph: ", (**frame)->best_effort_timestamp);
+        const auto err = av_buffersrc_add_frame(m_source, **frame);
+        if (err < 0) {
+            logInternal(LogLevel::Error, "Failed to submit frame to filter graph: ", getFfmpegErrorString(err));
+            return false;
+        }
+    }
+    // Drain the sink back over the inputs in order, any inputs left over remain empty for the caller to discard
+    for (auto* const frame : frames) {
+        const auto err = av_buffersink_get_frame(m_sink, **frame);
+        if (err < 0) {
+            if ((err == AVERROR(EAGAIN)) || (err == AVERROR_EOF)) {
+                break;
+            }
+            logInternal(LogLevel::Error, "Failed to receive frame from filter graph: ", getFfmpegErrorString(err));
+            return false;
+        }
+        LOG_DEBUG("sendReceiveFrames- Received frame from filter graph: ", (**frame)->best_effort_timestamp);
+    }
+    return true;
+}
+
 uint32_t Filter::getWidth() const noexcept
 {
     return av_buffersink_get_w(m_sink);
@@ -20,18 +20,23 @@ __device__ __forceinline__ float clamp(const float f, const float a, const float
     return fmaxf(a, fminf(f, b));
 }
 
-__device__ __forceinline__ float3 YUVToRGB(const uchar3 yuv)
+__device__ __forceinline__ float3 YUVToRGB(const float3 yuv)
 {
     // Get YCbCr values
-    const float luma = static_cast<float>(yuv.x);
-    const float chromaCb = static_cast<float>(yuv.y) - 128.0f;
-    const float chromaCr = static_cast<float>(yuv.z) - 128.0f;
+    const float luma = yuv.x;
+    const float chromaCb = yuv.y - 128.0f;
+    const float chromaCr = yuv.z - 128.0f;
 
     // Convert to RGB using BT601
     return make_float3(
         luma + 1.13983 * chromaCr, luma - 0.39465f * chromaCb - 0.58060f * chromaCr, luma + 2.03211f * chromaCb);
 }
 
+__device__ __forceinline__ float3 YUVToRGB(const uchar3 yuv)
+{
+    return YUVToRGB(make_float3(yuv.x, yuv.y, yuv.z));
+}
+
 struct Pixel2
 {
     float3 m_pixels[2];
@@ -147,6 +152,20 @@ __device__ __forceinline__ void convertNV12ToRGBP(const NV12Planes source, const
     dest.m_plane3[destOffset + 1] = pixel2.z;
 }
 
+__device__ __forceinline__ float3 getNV12Pixel(
+    const uint32_t x, const uint32_t y, const NV12Planes source, const uint32_t sourceStep)
+{
+    const float luma = source.m_plane1[y * sourceStep + x];
+    const uint32_t chromaOffset = (y >> 1) * sourceStep + (x & ~1u);
+    return make_float3(luma, source.m_plane2[chromaOffset], source.m_plane2[chromaOffset + 1]);
+}
+
+__device__ __forceinline__ float3 lerp3(const float3 a, const float3 b, const float weight)
+{
+    return make_float3(
+        a.x + weight * (b.x - a.x), a.y + weight * (b.y - a.y), a.z + weight * (b.z - a.z));
+}
+
 extern "C" {
 __global__ void convertNV12ToRGB8P(const NV12Planes source, const uint32_t sourceStep, const uint32_t width,
     const uint32_t height, const RGBPlanes<uint8_t> dest, const uint32_t destStep)
@@ -159,4 +178,122 @@ __global__ void convertNV12ToRGB32FP(const NV12Planes source, const uint32_t sou
 {
     convertNV12ToRGBP<float>(source, sourceStep, width, height, dest, destStep / sizeof(float));
 }
+
+/**
+ * Crop + bilinear scale of an NV12 frame to a new NV12 frame. Each thread resamples one output luma pixel from the
+ * cropped source region; threads covering the top-left pixel of each 2x2 block additionally resample the interleaved
+ * chroma pair at half resolution. This keeps device decoded frames on the GPU instead of routing them through the
+ * software filter graph.
+ */
+__global__ void cropScaleNV12(const NV12Planes source, const uint32_t sourceStep, const uint32_t cropLeft,
+    const uint32_t cropTop, const uint32_t cropWidth, const uint32_t cropHeight, const NV12Planes dest,
+    const uint32_t destStep, const uint32_t destWidth, const uint32_t destHeight)
+{
+    const uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+    const uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+
+    if (x >= destWidth || y >= destHeight) {
+        return;
+    }
+
+    const float scaleX = static_cast<float>(cropWidth) / static_cast<float>(destWidth);
+    const float scaleY = static_cast<float>(cropHeight) / static_cast<float>(destHeight);
+
+    // Bilinearly resample the luma plane
+    {
+        const float sourceX = clamp((static_cast<float>(x) + 0.5f) * scaleX - 0.5f, 0.0f, cropWidth - 1.0f);
+        const float sourceY = clamp((static_cast<float>(y) + 0.5f) * scaleY - 0.5f, 0.0f, cropHeight - 1.0f);
+        const uint32_t x0 = static_cast<uint32_t>(sourceX);
+        const uint32_t y0 = static_cast<uint32_t>(sourceY);
+        const uint32_t x1 = min(x0 + 1, cropWidth - 1);
+        const uint32_t y1 = min(y0 + 1, cropHeight - 1);
+        const float weightX = sourceX - static_cast<float>(x0);
+        const float weightY = sourceY - static_cast<float>(y0);
+        const uint8_t* const plane = source.m_plane1;
+        const float top = plane[(cropTop + y0) * sourceStep + cropLeft + x0] +
+            weightX *
+                (plane[(cropTop + y0) * sourceStep + cropLeft + x1] -
+                    static_cast<float>(plane[(cropTop + y0) * sourceStep + cropLeft + x0]));
+        const float bottom = plane[(cropTop + y1) * sourceStep + cropLeft + x0] +
+            weightX *
+                (plane[(cropTop + y1) * sourceStep + cropLeft + x1] -
+                    static_cast<float>(plane[(cropTop + y1) * sourceStep + cropLeft + x0]));
+        dest.m_plane1[y * destStep + x] =
+            static_cast<uint8_t>(clamp(top + weightY * (bottom - top) + 0.5f, 0.0f, 255.0f));
+    }
+
+    // The top-left thread of each 2x2 block resamples the shared chroma pair
+    if ((x & 1) == 0 && (y & 1) == 0) {
+        const uint32_t chromaCropWidth = cropWidth >> 1;
+        const uint32_t chromaCropHeight = cropHeight >> 1;
+        const uint32_t chromaX = x >> 1;
+        const uint32_t chromaY = y >> 1;
+        const float sourceX =
+            clamp((static_cast<float>(chromaX) + 0.5f) * scaleX - 0.5f, 0.0f, chromaCropWidth - 1.0f);
+        const float sourceY =
+            clamp((static_cast<float>(chromaY) + 0.5f) * scaleY - 0.5f, 0.0f, chromaCropHeight - 1.0f);
+        const uint32_t x0 = static_cast<uint32_t>(sourceX);
+        const uint32_t y0 = static_cast<uint32_t>(sourceY);
+        const uint32_t x1 = min(x0 + 1, chromaCropWidth - 1);
+        const uint32_t y1 = min(y0 + 1, chromaCropHeight - 1);
+        const float weightX = sourceX - static_cast<float>(x0);
+        const float weightY = sourceY - static_cast<float>(y0);
+        const uint8_t* const plane = source.m_plane2;
+        const uint32_t chromaLeft = cropLeft >> 1;
+        const uint32_t chromaTop = cropTop >> 1;
+        const uint32_t destOffset = chromaY * destStep + (chromaX << 1);
+        for (uint32_t channel = 0; channel < 2; channel++) {
+            const uint32_t offset00 = (chromaTop + y0) * sourceStep + ((chromaLeft + x0) << 1) + channel;
+            const uint32_t offset10 = (chromaTop + y0) * sourceStep + ((chromaLeft + x1) << 1) + channel;
+            const uint32_t offset01 = (chromaTop + y1) * sourceStep + ((chromaLeft + x0) << 1) + channel;
+            const uint32_t offset11 = (chromaTop + y1) * sourceStep + ((chromaLeft + x1) << 1) + channel;
+            const float top = plane[offset00] + weightX * (plane[offset10] - static_cast<float>(plane[offset00]));
+            const float bottom = plane[offset01] + weightX * (plane[offset11] - static_cast<float>(plane[offset01]));
+            dest.m_plane2[destOffset + channel] =
+                static_cast<uint8_t>(clamp(top + weightY * (bottom - top) + 0.5f, 0.0f, 255.0f));
+        }
+    }
+}
+
+/**
+ * Fused crop + bilinear scale + colour conversion + normalisation. Each thread computes one output pixel by
+ * bilinearly sampling the cropped NV12 source region, converting to RGB and applying (rgb - mean) * invStd to the
+ * normalised 0..1 values. This performs the whole pre-processing chain in a single pass over memory. The output is
+ * written as a tightly packed planar float tensor.
+ */
+__global__ void preProcessNV12ToRGB32FP(const NV12Planes source, const uint32_t sourceStep, const uint32_t cropLeft,
+    const uint32_t cropTop, const uint32_t cropWidth, const uint32_t cropHeight, const RGBPlanes<float> dest,
+    const uint32_t destWidth, const uint32_t destHeight, const float3 mean, const float3 invStd)
+{
+    const uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+    const uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+
+    if (x >= destWidth || y >= destHeight) {
+        return;
+    }
+
+    // Map the output pixel back to the centre of its footprint in the cropped source region
+    const float scaleX = static_cast<float>(cropWidth) / static_cast<float>(destWidth);
+    const float scaleY = static_cast<float>(cropHeight) / static_cast<float>(destHeight);
+    const float sourceX = clamp((static_cast<float>(x) + 0.5f) * scaleX - 0.5f, 0.0f, cropWidth - 1.0f);
+    const float sourceY = clamp((static_cast<float>(y) + 0.5f) * scaleY - 0.5f, 0.0f, cropHeight - 1.0f);
+    const uint32_t x0 = static_cast<uint32_t>(sourceX);
+    const uint32_t y0 = static_cast<uint32_t>(sourceY);
+    const uint32_t x1 = min(x0 + 1, cropWidth - 1);
+    const uint32_t y1 = min(y0 + 1, cropHeight - 1);
+    const float weightX = sourceX - static_cast<float>(x0);
+    const float weightY = sourceY - static_cast<float>(y0);
+
+    // Bilinearly interpolate in YUV space then convert the filtered sample
+    const float3 top = lerp3(getNV12Pixel(cropLeft + x0, cropTop + y0, source, sourceStep),
+        getNV12Pixel(cropLeft + x1, cropTop + y0, source, sourceStep), weightX);
+    const float3 bottom = lerp3(getNV12Pixel(cropLeft + x0, cropTop + y1, source, sourceStep),
+        getNV12Pixel(cropLeft + x1, cropTop + y1, source, sourceStep), weightX);
+    const float3 rgb = YUVToRGB(lerp3(top, bottom, weightY));
+
+    const uint32_t destOffset = y * destWidth + x;
+    dest.m_plane1[destOffset] = (__saturatef(rgb.x / 255.0f) - mean.x) * invStd.x;
+    dest.m_plane2[destOffset] = (__saturatef(rgb.y / 255.0f) - mean.y) * invStd.y;
+    dest.m_plane3[destOffset] = (__saturatef(rgb.z / 255.0f) - mean.z) * invStd.z;
+}
 }
\ No newline at end of file
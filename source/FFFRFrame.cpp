@@ -15,6 +15,7 @@
  */
 #include "FFFRFrame.h"
 
+#include "FFFRDLPack.h"
 #include "FFFRUtility.h"
 
 #include <algorithm>
@@ -110,4 +111,90 @@ DecodeType Frame::getDataType() const noexcept
     }
     return DecodeType::Software;
 }
+
+namespace {
+/** Ownership block keeping a frame alive for the lifetime of an exported DLPack tensor. */
+struct DLPackExport
+{
+    std::shared_ptr<Frame> m_owner; /**< Reference keeping the exported frames memory valid */
+    DLManagedTensor m_tensor;       /**< The exported tensor handed to the consumer */
+    int64_t m_shape[3];             /**< Storage for the tensor shape */
+    int64_t m_strides[3];           /**< Storage for the tensor strides */
+};
+
+void dlPackDeleter(DLManagedTensor* const tensor)
+{
+    delete static_cast<DLPackExport*>(tensor->manager_ctx);
+}
+} // namespace
+
+DLManagedTensor* Frame::toDLPack(const uint32_t plane) noexcept
+{
+    const auto data = getFrameData(plane);
+    if (data.first == nullptr) {
+        logInternal(LogLevel::Error, "Invalid plane requested for DLPack export: ", plane);
+        return nullptr;
+    }
+    const auto format = getPixelFormat();
+    const uint32_t elemSize = format == PixelFormat::RGB32FP ? sizeof(float) : sizeof(uint8_t);
+    // Determine the extents of the requested plane
+    int32_t numDims = 2;
+    int64_t width = getWidth();
+    int64_t height = getHeight();
+    int64_t channels = 1;
+    switch (format) {
+        case PixelFormat::YUV420P:
+            if (plane > 0) {
+                width = (width + 1) / 2;
+                height = (height + 1) / 2;
+            }
+            break;
+        case PixelFormat::YUV422P:
+            if (plane > 0) {
+                width = (width + 1) / 2;
+            }
+            break;
+        case PixelFormat::NV12:
+            if (plane > 0) {
+                // The second plane holds interleaved chroma pairs
+                width = (width + 1) / 2;
+                height = (height + 1) / 2;
+                channels = 2;
+                numDims = 3;
+            }
+            break;
+        case PixelFormat::RGB8:
+            channels = 3;
+            numDims = 3;
+            break;
+        default:
+            break;
+    }
+    try {
+        auto exported = std::make_unique<DLPackExport>();
+        // Keep the frame (and with it the underlying buffer reference) alive until the deleter is called
+        exported->m_owner = shared_from_this();
+        exported->m_shape[0] = height;
+        exported->m_shape[1] = width;
+        exported->m_shape[2] = channels;
+        exported->m_strides[0] = data.second / static_cast<int32_t>(elemSize);
+        exported->m_strides[1] = channels;
+        exported->m_strides[2] = 1;
+        auto& tensor = exported->m_tensor;
+        tensor.dl_tensor.data = data.first;
+        tensor.dl_tensor.device = {getDataType() == DecodeType::Cuda ? kDLCUDA : kDLCPU, 0};
+        tensor.dl_tensor.ndim = numDims;
+        tensor.dl_tensor.dtype = {
+            static_cast<uint8_t>(format == PixelFormat::RGB32FP ? kDLFloat : kDLUInt), static_cast<uint8_t>(elemSize * 8), 1};
+        tensor.dl_tensor.shape = exported->m_shape;
+        tensor.dl_tensor.strides = exported->m_strides;
+        tensor.dl_tensor.byte_offset = 0;
+        tensor.manager_ctx = exported.get();
+        tensor.deleter = &dlPackDeleter;
+        return &exported.release()->m_tensor;
+    } catch (...) {
+        logInternal(LogLevel::Error, "DLPack export requires a frame retrieved from a stream");
+        return nullptr;
+    }
+}
 } // namespace Ffr
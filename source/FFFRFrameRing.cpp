@@ -0,0 +1,110 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRFrameRing.h"
+
+#include "FFFRFrame.h"
+#include "FFFRUtility.h"
+
+using namespace std;
+
+namespace Ffr {
+bool FrameRing::reserve(const uint32_t capacity) noexcept
+{
+    // Round the capacity up to a power of two so positions can be wrapped using a mask
+    uint32_t length = 1;
+    while (length < capacity) {
+        length <<= 1;
+    }
+    try {
+        m_frames.resize(length);
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to allocate frame ring storage: ", length);
+        return false;
+    }
+    m_mask = length - 1;
+    m_head = 0;
+    m_tail = 0;
+    return true;
+}
+
+bool FrameRing::push(std::shared_ptr<Frame> frame) noexcept
+{
+    const auto tail = m_tail.load(memory_order_relaxed);
+    if (tail - m_head.load(memory_order_acquire) > m_mask) {
+        // The ring is full
+        return false;
+    }
+    m_frames[tail & m_mask] = move(frame);
+    // Publish the frame to the consumer
+    m_tail.store(tail + 1, memory_order_release);
+    return true;
+}
+
+shared_ptr<Frame> FrameRing::front() const noexcept
+{
+    const auto head = m_head.load(memory_order_relaxed);
+    if (m_tail.load(memory_order_acquire) == head) {
+        return nullptr;
+    }
+    return m_frames[head & m_mask];
+}
+
+shared_ptr<Frame> FrameRing::back() const noexcept
+{
+    const auto tail = m_tail.load(memory_order_acquire);
+    if (tail == m_head.load(memory_order_relaxed)) {
+        return nullptr;
+    }
+    return m_frames[(tail - 1) & m_mask];
+}
+
+void FrameRing::pop() noexcept
+{
+    const auto head = m_head.load(memory_order_relaxed);
+    if (m_tail.load(memory_order_acquire) == head) {
+        return;
+    }
+    // Release the frame reference before making the slot available to the producer
+    m_frames[head & m_mask].reset();
+    m_head.store(head + 1, memory_order_release);
+}
+
+uint32_t FrameRing::size() const noexcept
+{
+    return m_tail.load(memory_order_acquire) - m_head.load(memory_order_acquire);
+}
+
+bool FrameRing::empty() const noexcept
+{
+    return size() == 0;
+}
+
+uint32_t FrameRing::space() const noexcept
+{
+    return (m_mask + 1) - size();
+}
+
+void FrameRing::clear() noexcept
+{
+    auto head = m_head.load(memory_order_relaxed);
+    const auto tail = m_tail.load(memory_order_relaxed);
+    while (head != tail) {
+        m_frames[head & m_mask].reset();
+        ++head;
+    }
+    m_head.store(head, memory_order_release);
+}
+} // namespace Ffr
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRHostConvert.h"
+
+#include "FFFRFrame.h"
+#include "FFFRUtility.h"
+#include "FFFrameReader.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+}
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#    define FFFR_HOST_CONVERT_X86 1
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        include <intrin.h>
+#    endif
+#else
+#    define FFFR_HOST_CONVERT_X86 0
+#endif
+
+using namespace std;
+
+namespace Ffr {
+static bool hasAVX2() noexcept
+{
+#if FFFR_HOST_CONVERT_X86
+#    if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuidex(info, 0, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    __cpuidex(info, 1, 0);
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    return avx2 && fma;
+#    else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#    endif
+#else
+    return false;
+#endif
+}
+
+template<typename T>
+static void convertNV12ToRGBP(const uint8_t* const srcY, const uint8_t* const srcUV, const uint32_t srcStepY,
+    const uint32_t srcStepUV, const uint32_t width, const uint32_t height, const HostRGBPlanes<T> dest,
+    const uint32_t destStep) noexcept
+{
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* const lineY = srcY + y * srcStepY;
+        const uint8_t* const lineUV = srcUV + (y >> 1) * srcStepUV;
+        T* const lineR = dest.m_plane1 + y * destStep;
+        T* const lineG = dest.m_plane2 + y * destStep;
+        T* const lineB = dest.m_plane3 + y * destStep;
+        for (uint32_t x = 0; x < width; ++x) {
+            // Chroma samples are shared by each pair of horizontal pixels
+            const uint32_t chroma = x & ~1u;
+            hostConvertPixel<T>(lineY[x], lineUV[chroma], lineUV[chroma + 1], lineR + x, lineG + x, lineB + x);
+        }
+    }
+}
+
+template<typename T>
+static void convertYUV420PToRGBP(const uint8_t* const srcY, const uint8_t* const srcU, const uint8_t* const srcV,
+    const uint32_t srcStepY, const uint32_t srcStepC, const uint32_t width, const uint32_t height,
+    const HostRGBPlanes<T> dest, const uint32_t destStep) noexcept
+{
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* const lineY = srcY + y * srcStepY;
+        const uint8_t* const lineU = srcU + (y >> 1) * srcStepC;
+        const uint8_t* const lineV = srcV + (y >> 1) * srcStepC;
+        T* const lineR = dest.m_plane1 + y * destStep;
+        T* const lineG = dest.m_plane2 + y * destStep;
+        T* const lineB = dest.m_plane3 + y * destStep;
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint32_t chroma = x >> 1;
+            hostConvertPixel<T>(lineY[x], lineU[chroma], lineV[chroma], lineR + x, lineG + x, lineB + x);
+        }
+    }
+}
+
+bool hostConvertFormat(const std::shared_ptr<Frame>& frame, uint8_t* const outMem, const PixelFormat outFormat) noexcept
+{
+    if (frame == nullptr || outMem == nullptr) {
+        logInternal(LogLevel::Error, "Invalid frame");
+        return false;
+    }
+    if (frame->getDataType() != DecodeType::Software) {
+        logInternal(LogLevel::Error, "Only host frames are supported by hostConvertFormat");
+        return false;
+    }
+    const auto inFormat = frame->getPixelFormat();
+    if ((inFormat != PixelFormat::NV12 && inFormat != PixelFormat::YUV420P) ||
+        (outFormat != PixelFormat::RGB8P && outFormat != PixelFormat::RGB32FP)) {
+        logInternal(LogLevel::Error, "Format conversion not currently supported");
+        return false;
+    }
+    const auto width = frame->getWidth();
+    const auto height = frame->getHeight();
+
+    uint8_t* outPlanes[4];
+    int32_t outStep[4];
+    av_image_fill_arrays(outPlanes, outStep, outMem, getPixelFormat(outFormat), width, height, 32);
+
+    const auto data1 = frame->getFrameData(0);
+    const auto data2 = frame->getFrameData(1);
+    // Runtime detect cpu support for the vectorised kernels
+    static const bool useAVX2 = hasAVX2();
+    if (inFormat == PixelFormat::NV12) {
+        if (outFormat == PixelFormat::RGB8P) {
+            const HostRGBPlanes<uint8_t> dest{outPlanes[0], outPlanes[1], outPlanes[2]};
+            if (useAVX2) {
+                convertNV12ToRGB8PAVX2(
+                    data1.first, data2.first, data1.second, data2.second, width, height, dest, outStep[0]);
+            } else {
+                convertNV12ToRGBP<uint8_t>(
+                    data1.first, data2.first, data1.second, data2.second, width, height, dest, outStep[0]);
+            }
+        } else {
+            const HostRGBPlanes<float> dest{reinterpret_cast<float*>(outPlanes[0]),
+                reinterpret_cast<float*>(outPlanes[1]), reinterpret_cast<float*>(outPlanes[2])};
+            const auto destStep = static_cast<uint32_t>(outStep[0]) / sizeof(float);
+            if (useAVX2) {
+                convertNV12ToRGB32FPAVX2(
+                    data1.first, data2.first, data1.second, data2.second, width, height, dest, destStep);
+            } else {
+                convertNV12ToRGBP<float>(
+                    data1.first, data2.first, data1.second, data2.second, width, height, dest, destStep);
+            }
+        }
+    } else {
+        const auto data3 = frame->getFrameData(2);
+        if (outFormat == PixelFormat::RGB8P) {
+            const HostRGBPlanes<uint8_t> dest{outPlanes[0], outPlanes[1], outPlanes[2]};
+            if (useAVX2) {
+                convertYUV420PToRGB8PAVX2(data1.first, data2.first, data3.first, data1.second, data2.second, width,
+                    height, dest, outStep[0]);
+            } else {
+                convertYUV420PToRGBP<uint8_t>(data1.first, data2.first, data3.first, data1.second, data2.second, width,
+                    height, dest, outStep[0]);
+            }
+        } else {
+            const HostRGBPlanes<float> dest{reinterpret_cast<float*>(outPlanes[0]),
+                reinterpret_cast<float*>(outPlanes[1]), reinterpret_cast<float*>(outPlanes[2])};
+            const auto destStep = static_cast<uint32_t>(outStep[0]) / sizeof(float);
+            if (useAVX2) {
+                convertYUV420PToRGB32FPAVX2(
+                    data1.first, data2.first, data3.first, data1.second, data2.second, width, height, dest, destStep);
+            } else {
+                convertYUV420PToRGBP<float>(
+                    data1.first, data2.first, data3.first, data1.second, data2.second, width, height, dest, destStep);
+            }
+        }
+    }
+    return true;
+}
+
+#if !FFFR_HOST_CONVERT_X86
+// Non-x86 builds fall back to the scalar kernels which the compiler is free to auto-vectorise
+void convertNV12ToRGB8PAVX2(const uint8_t* const srcY, const uint8_t* const srcUV, const uint32_t srcStepY,
+    const uint32_t srcStepUV, const uint32_t width, const uint32_t height, const HostRGBPlanes<uint8_t> dest,
+    const uint32_t destStep) noexcept
+{
+    convertNV12ToRGBP<uint8_t>(srcY, srcUV, srcStepY, srcStepUV, width, height, dest, destStep);
+}
+
+void convertNV12ToRGB32FPAVX2(const uint8_t* const srcY, const uint8_t* const srcUV, const uint32_t srcStepY,
+    const uint32_t srcStepUV, const uint32_t width, const uint32_t height, const HostRGBPlanes<float> dest,
+    const uint32_t destStep) noexcept
+{
+    convertNV12ToRGBP<float>(srcY, srcUV, srcStepY, srcStepUV, width, height, dest, destStep);
+}
+
+void convertYUV420PToRGB8PAVX2(const uint8_t* const srcY, const uint8_t* const srcU, const uint8_t* const srcV,
+    const uint32_t srcStepY, const uint32_t srcStepC, const uint32_t width, const uint32_t height,
+    const HostRGBPlanes<uint8_t> dest, const uint32_t destStep) noexcept
+{
+    convertYUV420PToRGBP<uint8_t>(srcY, srcU, srcV, srcStepY, srcStepC, width, height, dest, destStep);
+}
+
+void convertYUV420PToRGB32FPAVX2(const uint8_t* const srcY, const uint8_t* const srcU, const uint8_t* const srcV,
+    const uint32_t srcStepY, const uint32_t srcStepC, const uint32_t width, const uint32_t height,
+    const HostRGBPlanes<float> dest, const uint32_t destStep) noexcept
+{
+    convertYUV420PToRGBP<float>(srcY, srcU, srcV, srcStepY, srcStepC, width, height, dest, destStep);
+}
+#endif
+} // namespace Ffr
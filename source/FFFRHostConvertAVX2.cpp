@@ -0,0 +1,171 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRHostConvert.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+
+#    include <immintrin.h>
+
+namespace Ffr {
+namespace {
+/** Vectorised YCbCr->RGB conversion state for 8 horizontal pixels */
+struct RGBVec
+{
+    __m256 m_r;
+    __m256 m_g;
+    __m256 m_b;
+};
+
+/** Convert 8 luma and 8 expanded chroma samples to RGB using the same BT601 maths as the scalar kernels */
+inline RGBVec convertVec(const __m256 luma, const __m256 chromaCb, const __m256 chromaCr) noexcept
+{
+    const __m256 offset = _mm256_set1_ps(128.0f);
+    const __m256 cb = _mm256_sub_ps(chromaCb, offset);
+    const __m256 cr = _mm256_sub_ps(chromaCr, offset);
+    RGBVec ret;
+    ret.m_r = _mm256_fmadd_ps(_mm256_set1_ps(1.13983f), cr, luma);
+    ret.m_g = _mm256_fnmadd_ps(_mm256_set1_ps(0.58060f), cr, _mm256_fnmadd_ps(_mm256_set1_ps(0.39465f), cb, luma));
+    ret.m_b = _mm256_fmadd_ps(_mm256_set1_ps(2.03211f), cb, luma);
+    return ret;
+}
+
+/** Widen 8 packed byte samples to 8 packed floats */
+inline __m256 bytesToFloat(const __m128i bytes) noexcept
+{
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+}
+
+/** Clamp 8 float samples to 0..255 and store them as bytes */
+inline void storeBytes(const __m256 values, uint8_t* const dest) noexcept
+{
+    // Truncate to match the scalar kernels
+    const __m256i ints = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(values, _mm256_setzero_ps()),
+        _mm256_set1_ps(255.0f)));
+    const __m128i packed16 = _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dest), _mm_packus_epi16(packed16, packed16));
+}
+
+/** Normalise 8 float samples to 0..1 and store them */
+inline void storeFloats(const __m256 values, float* const dest) noexcept
+{
+    const __m256 norm = _mm256_mul_ps(values, _mm256_set1_ps(1.0f / 255.0f));
+    _mm256_storeu_ps(dest, _mm256_min_ps(_mm256_max_ps(norm, _mm256_setzero_ps()), _mm256_set1_ps(1.0f)));
+}
+
+inline void storeRGB(const RGBVec rgb, uint8_t* const destR, uint8_t* const destG, uint8_t* const destB) noexcept
+{
+    storeBytes(rgb.m_r, destR);
+    storeBytes(rgb.m_g, destG);
+    storeBytes(rgb.m_b, destB);
+}
+
+inline void storeRGB(const RGBVec rgb, float* const destR, float* const destG, float* const destB) noexcept
+{
+    storeFloats(rgb.m_r, destR);
+    storeFloats(rgb.m_g, destG);
+    storeFloats(rgb.m_b, destB);
+}
+
+template<typename T>
+void convertNV12ToRGBPAVX2(const uint8_t* const srcY, const uint8_t* const srcUV, const uint32_t srcStepY,
+    const uint32_t srcStepUV, const uint32_t width, const uint32_t height, const HostRGBPlanes<T> dest,
+    const uint32_t destStep) noexcept
+{
+    // Expand 8 interleaved UV bytes so each chroma sample covers its pair of horizontal pixels
+    const __m128i maskCb = _mm_set_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 6, 6, 4, 4, 2, 2, 0, 0);
+    const __m128i maskCr = _mm_set_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 7, 7, 5, 5, 3, 3, 1, 1);
+    const uint32_t widthAligned = width & ~7u;
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* const lineY = srcY + y * srcStepY;
+        const uint8_t* const lineUV = srcUV + (y >> 1) * srcStepUV;
+        T* const lineR = dest.m_plane1 + y * destStep;
+        T* const lineG = dest.m_plane2 + y * destStep;
+        T* const lineB = dest.m_plane3 + y * destStep;
+        for (uint32_t x = 0; x < widthAligned; x += 8) {
+            const __m128i luma = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(lineY + x));
+            const __m128i chroma = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(lineUV + x));
+            const auto rgb = convertVec(bytesToFloat(luma), bytesToFloat(_mm_shuffle_epi8(chroma, maskCb)),
+                bytesToFloat(_mm_shuffle_epi8(chroma, maskCr)));
+            storeRGB(rgb, lineR + x, lineG + x, lineB + x);
+        }
+        for (uint32_t x = widthAligned; x < width; ++x) {
+            const uint32_t chroma = x & ~1u;
+            hostConvertPixel<T>(lineY[x], lineUV[chroma], lineUV[chroma + 1], lineR + x, lineG + x, lineB + x);
+        }
+    }
+}
+
+template<typename T>
+void convertYUV420PToRGBPAVX2(const uint8_t* const srcY, const uint8_t* const srcU, const uint8_t* const srcV,
+    const uint32_t srcStepY, const uint32_t srcStepC, const uint32_t width, const uint32_t height,
+    const HostRGBPlanes<T> dest, const uint32_t destStep) noexcept
+{
+    // Duplicate 4 chroma bytes so each sample covers its pair of horizontal pixels
+    const __m128i maskC = _mm_set_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 3, 3, 2, 2, 1, 1, 0, 0);
+    const uint32_t widthAligned = width & ~7u;
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* const lineY = srcY + y * srcStepY;
+        const uint8_t* const lineU = srcU + (y >> 1) * srcStepC;
+        const uint8_t* const lineV = srcV + (y >> 1) * srcStepC;
+        T* const lineR = dest.m_plane1 + y * destStep;
+        T* const lineG = dest.m_plane2 + y * destStep;
+        T* const lineB = dest.m_plane3 + y * destStep;
+        for (uint32_t x = 0; x < widthAligned; x += 8) {
+            const __m128i luma = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(lineY + x));
+            const __m128i chromaCb = _mm_cvtsi32_si128(*reinterpret_cast<const int32_t*>(lineU + (x >> 1)));
+            const __m128i chromaCr = _mm_cvtsi32_si128(*reinterpret_cast<const int32_t*>(lineV + (x >> 1)));
+            const auto rgb = convertVec(bytesToFloat(luma), bytesToFloat(_mm_shuffle_epi8(chromaCb, maskC)),
+                bytesToFloat(_mm_shuffle_epi8(chromaCr, maskC)));
+            storeRGB(rgb, lineR + x, lineG + x, lineB + x);
+        }
+        for (uint32_t x = widthAligned; x < width; ++x) {
+            const uint32_t chroma = x >> 1;
+            hostConvertPixel<T>(lineY[x], lineU[chroma], lineV[chroma], lineR + x, lineG + x, lineB + x);
+        }
+    }
+}
+} // namespace
+
+void convertNV12ToRGB8PAVX2(const uint8_t* const srcY, const uint8_t* const srcUV, const uint32_t srcStepY,
+    const uint32_t srcStepUV, const uint32_t width, const uint32_t height, const HostRGBPlanes<uint8_t> dest,
+    const uint32_t destStep) noexcept
+{
+    convertNV12ToRGBPAVX2<uint8_t>(srcY, srcUV, srcStepY, srcStepUV, width, height, dest, destStep);
+}
+
+void convertNV12ToRGB32FPAVX2(const uint8_t* const srcY, const uint8_t* const srcUV, const uint32_t srcStepY,
+    const uint32_t srcStepUV, const uint32_t width, const uint32_t height, const HostRGBPlanes<float> dest,
+    const uint32_t destStep) noexcept
+{
+    convertNV12ToRGBPAVX2<float>(srcY, srcUV, srcStepY, srcStepUV, width, height, dest, destStep);
+}
+
+void convertYUV420PToRGB8PAVX2(const uint8_t* const srcY, const uint8_t* const srcU, const uint8_t* const srcV,
+    const uint32_t srcStepY, const uint32_t srcStepC, const uint32_t width, const uint32_t height,
+    const HostRGBPlanes<uint8_t> dest, const uint32_t destStep) noexcept
+{
+    convertYUV420PToRGBPAVX2<uint8_t>(srcY, srcU, srcV, srcStepY, srcStepC, width, height, dest, destStep);
+}
+
+void convertYUV420PToRGB32FPAVX2(const uint8_t* const srcY, const uint8_t* const srcU, const uint8_t* const srcV,
+    const uint32_t srcStepY, const uint32_t srcStepC, const uint32_t width, const uint32_t height,
+    const HostRGBPlanes<float> dest, const uint32_t destStep) noexcept
+{
+    convertYUV420PToRGBPAVX2<float>(srcY, srcU, srcV, srcStepY, srcStepC, width, height, dest, destStep);
+}
+} // namespace Ffr
+
+#endif
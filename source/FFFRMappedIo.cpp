@@ -0,0 +1,170 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRMappedIo.h"
+
+#include "FFFRUtility.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavformat/avio.h>
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace Ffr {
+MappedIo::MappedIo(const std::string& fileName) noexcept
+{
+#ifdef _WIN32
+    m_file = CreateFileA(
+        fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(m_file, &fileSize) == 0 || fileSize.QuadPart <= 0) {
+        return;
+    }
+    m_size = fileSize.QuadPart;
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr) {
+        return;
+    }
+    m_data = static_cast<uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr) {
+        return;
+    }
+#else
+    m_fd = open(fileName.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        return;
+    }
+    struct stat fileInfo = {};
+    if (fstat(m_fd, &fileInfo) != 0 || !S_ISREG(fileInfo.st_mode) || fileInfo.st_size <= 0) {
+        return;
+    }
+    m_size = fileInfo.st_size;
+    auto* const data = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        return;
+    }
+    m_data = static_cast<uint8_t*>(data);
+#endif
+
+    // Reads are served straight from the page cache so only a small staging buffer is needed
+    constexpr uint32_t bufferSize = 32768;
+    auto* const buffer = static_cast<uint8_t*>(av_malloc(bufferSize));
+    if (buffer == nullptr) {
+        logInternal(LogLevel::Error, "Failed to allocate I/O context buffer");
+        return;
+    }
+    m_context = avio_alloc_context(buffer, bufferSize, 0, this, &MappedIo::readPacket, nullptr, &MappedIo::seekIo);
+    if (m_context == nullptr) {
+        logInternal(LogLevel::Error, "Failed to allocate memory mapped I/O context");
+        av_free(buffer);
+    }
+}
+
+MappedIo::~MappedIo() noexcept
+{
+    if (m_context != nullptr) {
+        av_free(m_context->buffer);
+        avio_context_free(&m_context);
+    }
+#ifdef _WIN32
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != nullptr) {
+        CloseHandle(m_file);
+    }
+#else
+    if (m_data != nullptr) {
+        munmap(m_data, static_cast<size_t>(m_size));
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+#endif
+}
+
+bool MappedIo::isValid() const noexcept
+{
+    return m_context != nullptr;
+}
+
+AVIOContext* MappedIo::getContext() const noexcept
+{
+    return m_context;
+}
+
+int32_t MappedIo::readPacket(void* const opaque, uint8_t* const buffer, const int32_t size) noexcept
+{
+    auto* const io = static_cast<MappedIo*>(opaque);
+    const auto remaining = io->m_size - io->m_position;
+    if (remaining <= 0) {
+        return AVERROR_EOF;
+    }
+    const auto read = std::min(static_cast<int64_t>(size), remaining);
+    memcpy(buffer, io->m_data + io->m_position, static_cast<size_t>(read));
+    io->m_position += read;
+    return static_cast<int32_t>(read);
+}
+
+int64_t MappedIo::seekIo(void* const opaque, const int64_t offset, const int32_t whence) noexcept
+{
+    auto* const io = static_cast<MappedIo*>(opaque);
+    if ((whence & AVSEEK_SIZE) != 0) {
+        return io->m_size;
+    }
+    int64_t position;
+    switch (whence & ~AVSEEK_FORCE) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position = io->m_position + offset;
+            break;
+        case SEEK_END:
+            position = io->m_size + offset;
+            break;
+        default:
+            return AVERROR(EINVAL);
+    }
+    if (position < 0 || position > io->m_size) {
+        return AVERROR(EINVAL);
+    }
+    io->m_position = position;
+    return position;
+}
+} // namespace Ffr
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRMultiCrop.h"
+
+#include "FFFRUtility.h"
+
+#include <utility>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/hwcontext.h>
+}
+
+using namespace std;
+using namespace Ffr;
+
+namespace Fmc {
+shared_ptr<MultiCrop> MultiCrop::getMultiCrop(
+    const std::string& fileName, const std::vector<Ffr::Crop>& cropList, const Ffr::DecoderOptions& options) noexcept
+{
+    if (cropList.empty()) {
+        logInternal(LogLevel::Error, "Multi-crop requires at least one crop region: ", fileName);
+        return nullptr;
+    }
+    try {
+        // The stream is opened without any global crop/scale as cropping is performed per output region instead
+        DecoderOptions streamOptions = options;
+        if (streamOptions.m_crop.m_top != 0 || streamOptions.m_crop.m_bottom != 0 ||
+            streamOptions.m_crop.m_left != 0 || streamOptions.m_crop.m_right != 0 ||
+            streamOptions.m_scale.m_width != 0 || streamOptions.m_scale.m_height != 0) {
+            logInternal(LogLevel::Warning, "Multi-crop ignores the global crop/scale decoder options: ", fileName);
+            streamOptions.m_crop = {0, 0, 0, 0};
+            streamOptions.m_scale = {0, 0};
+        }
+        auto stream = Stream::getStream(fileName, streamOptions);
+        if (stream == nullptr) {
+            return nullptr;
+        }
+        // Check that each crop region leaves a usable output area
+        for (const auto& crop : cropList) {
+            if (crop.m_left + crop.m_right >= stream->getWidth() || crop.m_top + crop.m_bottom >= stream->getHeight()) {
+                logInternal(LogLevel::Error, "Multi-crop region is larger than the video frame: ", fileName);
+                return nullptr;
+            }
+        }
+        return make_shared<MultiCrop>(move(stream), cropList, ConstructorLock());
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create multi-crop stream: ", fileName);
+        return nullptr;
+    }
+}
+
+MultiCrop::MultiCrop(std::shared_ptr<Ffr::Stream> stream, std::vector<Ffr::Crop> cropList, ConstructorLock) noexcept
+    : m_stream(move(stream))
+    , m_cropList(move(cropList))
+{}
+
+vector<shared_ptr<Frame>> MultiCrop::getNextFrameGroup() noexcept
+{
+    // Decode a single frame and create one view of it per crop region
+    const auto frame = m_stream->getNextFrame();
+    if (frame == nullptr) {
+        return {};
+    }
+    try {
+        vector<shared_ptr<Frame>> ret;
+        ret.reserve(m_cropList.size());
+        for (const auto& crop : m_cropList) {
+            auto cropped = cropFrame(frame, crop);
+            if (cropped == nullptr) {
+                return {};
+            }
+            ret.emplace_back(move(cropped));
+        }
+        return ret;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to allocate multi-crop frame group");
+        return {};
+    }
+}
+
+uint32_t MultiCrop::getNumCrops() const noexcept
+{
+    return static_cast<uint32_t>(m_cropList.size());
+}
+
+shared_ptr<Stream> MultiCrop::getStream() const noexcept
+{
+    return m_stream;
+}
+
+bool MultiCrop::seek(const int64_t timeStamp) noexcept
+{
+    return m_stream->seek(timeStamp);
+}
+
+bool MultiCrop::seekFrame(const int64_t frame) noexcept
+{
+    return m_stream->seekFrame(frame);
+}
+
+shared_ptr<Frame> MultiCrop::cropFrame(const shared_ptr<Frame>& frame, const Crop& crop) const noexcept
+{
+    FramePtr cropped(av_frame_alloc());
+    if (*cropped == nullptr) {
+        logInternal(LogLevel::Error, "Failed to allocate cropped frame");
+        return nullptr;
+    }
+    // Create a new reference to the decoded frames data buffers so the view is zero-copy
+    const auto err = av_frame_ref(*cropped, *frame->m_frame);
+    if (err < 0) {
+        logInternal(LogLevel::Error, "Failed to reference decoded frame: ", getFfmpegErrorString(err));
+        return nullptr;
+    }
+    if (cropped->hw_frames_ctx != nullptr) {
+        // Device frames are NV12, the plane pointers are offset directly using the chroma alignment required by the
+        // interleaved UV plane (matches the addressing used by the GPU transform path)
+        const uint32_t left = crop.m_left - (crop.m_left & 1);
+        const uint32_t top = crop.m_top - (crop.m_top & 1);
+        cropped->data[0] += static_cast<size_t>(top) * cropped->linesize[0] + left;
+        cropped->data[1] += static_cast<size_t>(top / 2) * cropped->linesize[1] + left;
+        cropped->width -= static_cast<int32_t>(left + crop.m_right);
+        cropped->height -= static_cast<int32_t>(top + crop.m_bottom);
+    } else {
+        cropped->crop_top = crop.m_top;
+        cropped->crop_bottom = crop.m_bottom;
+        cropped->crop_left = crop.m_left;
+        cropped->crop_right = crop.m_right;
+        const auto err2 = av_frame_apply_cropping(*cropped, 0);
+        if (err2 < 0) {
+            logInternal(LogLevel::Error, "Failed to apply crop region: ", getFfmpegErrorString(err2));
+            return nullptr;
+        }
+    }
+    try {
+        auto ret = make_shared<Frame>();
+        ret->m_frame = move(cropped);
+        ret->m_timeStamp = frame->m_timeStamp;
+        ret->m_frameNum = frame->m_frameNum;
+        ret->m_formatContext = frame->m_formatContext;
+        ret->m_index = frame->m_index;
+        ret->m_codecContext = frame->m_codecContext;
+        return ret;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to allocate cropped frame");
+        return nullptr;
+    }
+}
+} // namespace Fmc
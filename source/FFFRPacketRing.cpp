@@ -0,0 +1,109 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRPacketRing.h"
+
+#include "FFFRUtility.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+using namespace std;
+
+namespace Ffr {
+PacketRing::~PacketRing() noexcept
+{
+    clear();
+}
+
+bool PacketRing::reserve(const uint32_t capacity) noexcept
+{
+    // Round the capacity up to a power of two so positions can be wrapped using a mask
+    uint32_t length = 1;
+    while (length < capacity) {
+        length <<= 1;
+    }
+    try {
+        m_packets.resize(length, nullptr);
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to allocate packet ring storage: ", length);
+        return false;
+    }
+    m_mask = length - 1;
+    m_head = 0;
+    m_tail = 0;
+    return true;
+}
+
+bool PacketRing::push(AVPacket* const packet) noexcept
+{
+    const auto tail = m_tail.load(memory_order_relaxed);
+    if (tail - m_head.load(memory_order_acquire) > m_mask) {
+        // The ring is full
+        return false;
+    }
+    m_packets[tail & m_mask] = packet;
+    // Publish the packet to the consumer
+    m_tail.store(tail + 1, memory_order_release);
+    return true;
+}
+
+AVPacket* PacketRing::front() const noexcept
+{
+    const auto head = m_head.load(memory_order_relaxed);
+    if (m_tail.load(memory_order_acquire) == head) {
+        return nullptr;
+    }
+    return m_packets[head & m_mask];
+}
+
+void PacketRing::pop() noexcept
+{
+    const auto head = m_head.load(memory_order_relaxed);
+    if (m_tail.load(memory_order_acquire) == head) {
+        return;
+    }
+    // Ownership of the packet has passed to the consumer via front()
+    m_packets[head & m_mask] = nullptr;
+    m_head.store(head + 1, memory_order_release);
+}
+
+uint32_t PacketRing::size() const noexcept
+{
+    return m_tail.load(memory_order_acquire) - m_head.load(memory_order_acquire);
+}
+
+bool PacketRing::empty() const noexcept
+{
+    return size() == 0;
+}
+
+uint32_t PacketRing::space() const noexcept
+{
+    return (m_mask + 1) - size();
+}
+
+void PacketRing::clear() noexcept
+{
+    auto head = m_head.load(memory_order_relaxed);
+    const auto tail = m_tail.load(memory_order_relaxed);
+    while (head != tail) {
+        av_packet_free(&m_packets[head & m_mask]);
+        ++head;
+    }
+    m_head.store(head, memory_order_release);
+}
+} // namespace Ffr
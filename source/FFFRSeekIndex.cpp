@@ -0,0 +1,240 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRSeekIndex.h"
+
+#include "FFFRUtility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace std;
+
+namespace Ffr {
+/** Magic number and layout version identifying a sidecar index file */
+constexpr uint64_t g_indexMagic = 0x5846464952584449ULL; /* "IDXRIFFX" */
+constexpr uint32_t g_indexVersion = 2;
+
+void SeekIndex::addSorted(std::vector<int64_t>& list, const int64_t timeStamp) noexcept
+{
+    try {
+        if (!list.empty() && timeStamp <= list.back()) {
+            if (binary_search(list.begin(), list.end(), timeStamp)) {
+                // Already indexed
+                return;
+            }
+            // Keep the index sorted when packets arrive out of order
+            list.insert(upper_bound(list.begin(), list.end(), timeStamp), timeStamp);
+            return;
+        }
+        list.emplace_back(timeStamp);
+    } catch (...) {
+    }
+}
+
+void SeekIndex::addKeyFrame(const int64_t timeStamp) noexcept
+{
+    addSorted(m_keyFrames, timeStamp);
+}
+
+void SeekIndex::addFrame(const int64_t timeStamp) noexcept
+{
+    addSorted(m_frames, timeStamp);
+}
+
+void SeekIndex::setComplete() noexcept
+{
+    m_complete = true;
+}
+
+bool SeekIndex::isComplete() const noexcept
+{
+    return m_complete;
+}
+
+uint32_t SeekIndex::getNumKeyFrames() const noexcept
+{
+    return static_cast<uint32_t>(m_keyFrames.size());
+}
+
+uint32_t SeekIndex::getNumFrames() const noexcept
+{
+    return static_cast<uint32_t>(m_frames.size());
+}
+
+bool SeekIndex::findKeyFrame(const int64_t timeStamp, int64_t& keyFrame) const noexcept
+{
+    if (!m_complete || m_keyFrames.empty()) {
+        return false;
+    }
+    // Find the latest keyframe at or before the requested time stamp
+    const auto found = upper_bound(m_keyFrames.begin(), m_keyFrames.end(), timeStamp);
+    if (found == m_keyFrames.begin()) {
+        return false;
+    }
+    keyFrame = *prev(found);
+    return true;
+}
+
+bool SeekIndex::findFrameTimeStamp(
+    const int64_t startTimeStamp, const int64_t frame, int64_t& timeStamp) const noexcept
+{
+    if (!m_complete || m_frames.empty() || frame < 0) {
+        return false;
+    }
+    // Frame numbers are counted from the frame at the streams detected start time
+    const auto base = lower_bound(m_frames.begin(), m_frames.end(), startTimeStamp) - m_frames.begin();
+    const auto position = base + frame;
+    if (position >= static_cast<int64_t>(m_frames.size())) {
+        return false;
+    }
+    timeStamp = m_frames[static_cast<size_t>(position)];
+    return true;
+}
+
+bool SeekIndex::findFrameNumber(const int64_t startTimeStamp, const int64_t timeStamp, int64_t& frame) const noexcept
+{
+    if (!m_complete || m_frames.empty()) {
+        return false;
+    }
+    // Find the latest frame at or before the requested time stamp
+    const auto found = upper_bound(m_frames.begin(), m_frames.end(), timeStamp);
+    if (found == m_frames.begin()) {
+        return false;
+    }
+    const auto base = lower_bound(m_frames.begin(), m_frames.end(), startTimeStamp) - m_frames.begin();
+    const auto position = (found - m_frames.begin()) - 1;
+    if (position < base) {
+        return false;
+    }
+    frame = position - base;
+    return true;
+}
+
+bool SeekIndex::load(const std::string& fileName, const int32_t index) noexcept
+{
+    try {
+        ifstream file(getSidecarFileName(fileName), ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        uint64_t magic = 0;
+        uint32_t version = 0;
+        int32_t streamIndex = -1;
+        uint64_t size = 0;
+        int64_t modified = 0;
+        uint64_t count = 0;
+        uint64_t frameCount = 0;
+        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&streamIndex), sizeof(streamIndex));
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        file.read(reinterpret_cast<char*>(&modified), sizeof(modified));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        file.read(reinterpret_cast<char*>(&frameCount), sizeof(frameCount));
+        if (!file.good() || magic != g_indexMagic || version != g_indexVersion || streamIndex != index) {
+            return false;
+        }
+        // Reject the sidecar if the source file has changed since the index was written
+        uint64_t currentSize = 0;
+        int64_t currentModified = 0;
+        if (!getFileSignature(fileName, currentSize, currentModified) || currentSize != size ||
+            currentModified != modified) {
+            logInternal(LogLevel::Info, "Ignoring stale seek index sidecar for file: ", fileName);
+            return false;
+        }
+        vector<int64_t> keyFrames(static_cast<size_t>(count));
+        file.read(reinterpret_cast<char*>(keyFrames.data()), static_cast<streamsize>(count * sizeof(int64_t)));
+        vector<int64_t> frames(static_cast<size_t>(frameCount));
+        file.read(reinterpret_cast<char*>(frames.data()), static_cast<streamsize>(frameCount * sizeof(int64_t)));
+        if (!file.good()) {
+            return false;
+        }
+        m_keyFrames = move(keyFrames);
+        m_frames = move(frames);
+        m_complete = true;
+        logInternal(LogLevel::Info, "Loaded seek index sidecar with keyframes: ", m_keyFrames.size());
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SeekIndex::save(const std::string& fileName, const int32_t index) const noexcept
+{
+    if (!m_complete) {
+        return false;
+    }
+    try {
+        uint64_t size = 0;
+        int64_t modified = 0;
+        if (!getFileSignature(fileName, size, modified)) {
+            return false;
+        }
+        ofstream file(getSidecarFileName(fileName), ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            logInternal(LogLevel::Warning, "Failed to create seek index sidecar for file: ", fileName);
+            return false;
+        }
+        const uint64_t count = m_keyFrames.size();
+        const uint64_t frameCount = m_frames.size();
+        file.write(reinterpret_cast<const char*>(&g_indexMagic), sizeof(g_indexMagic));
+        file.write(reinterpret_cast<const char*>(&g_indexVersion), sizeof(g_indexVersion));
+        file.write(reinterpret_cast<const char*>(&index), sizeof(index));
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char*>(&modified), sizeof(modified));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+        file.write(
+            reinterpret_cast<const char*>(m_keyFrames.data()), static_cast<streamsize>(count * sizeof(int64_t)));
+        file.write(
+            reinterpret_cast<const char*>(m_frames.data()), static_cast<streamsize>(frameCount * sizeof(int64_t)));
+        return file.good();
+    } catch (...) {
+        return false;
+    }
+}
+
+string SeekIndex::getSidecarFileName(const std::string& fileName) noexcept
+{
+    try {
+        return fileName + ".ffindex";
+    } catch (...) {
+        return {};
+    }
+}
+
+bool SeekIndex::getFileSignature(const std::string& fileName, uint64_t& size, int64_t& modified) noexcept
+{
+    try {
+        error_code error;
+        const auto fileSize = filesystem::file_size(fileName, error);
+        if (error) {
+            return false;
+        }
+        const auto fileTime = filesystem::last_write_time(fileName, error);
+        if (error) {
+            return false;
+        }
+        size = static_cast<uint64_t>(fileSize);
+        modified = static_cast<int64_t>(fileTime.time_since_epoch().count());
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+} // namespace Ffr
@@ -15,13 +15,22 @@
  */
 #include "FFFRStream.h"
 
+#include "FFFRConfig.h"
+#include "FFFRDecodeScheduler.h"
 #include "FFFRDecoderContext.h"
 #include "FFFRFilter.h"
+#include "FFFRCachedIo.h"
+#include "FFFRGpuTransform.h"
+#include "FFFRMappedIo.h"
+#include "FFFRStreamMetadata.h"
 #include "FFFRStreamUtils.h"
+#include "FFFRTaskPool.h"
 #include "FFFRUtility.h"
 #include "FFFrameReader.h"
 
 #include <algorithm>
+#include <chrono>
+#include <numeric>
 #include <string>
 using namespace std;
 
@@ -29,18 +38,86 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavfilter/buffersink.h>
 #include <libavformat/avformat.h>
+#include <libavutil/hwcontext.h>
+#if FFFR_BUILD_CUDA
+#    include <libavutil/hwcontext_cuda.h>
+#endif
 #include <libavutil/imgutils.h>
 #include <libavutil/log.h>
 #include <libavutil/opt.h>
+#include <libavutil/pixdesc.h>
 }
 
 namespace Ffr {
+/**
+ * Raises an atomic watermark to a sample value if it is larger.
+ * @param [in,out] mark   The watermark to update.
+ * @param          sample The observed sample.
+ */
+static void raiseWaterMark(std::atomic<uint32_t>& mark, const uint32_t sample) noexcept
+{
+    auto current = mark.load(memory_order_relaxed);
+    while (sample > current && !mark.compare_exchange_weak(current, sample, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * Lowers an atomic watermark to a sample value if it is smaller.
+ * @param [in,out] mark   The watermark to update.
+ * @param          sample The observed sample.
+ */
+static void lowerWaterMark(std::atomic<uint32_t>& mark, const uint32_t sample) noexcept
+{
+    auto current = mark.load(memory_order_relaxed);
+    while (sample < current && !mark.compare_exchange_weak(current, sample, memory_order_relaxed)) {
+    }
+}
+
 Stream::Stream(const std::string& fileName, uint32_t bufferLength, const uint32_t seekThreshold, bool noBufferFlush,
-    const std::shared_ptr<DecoderContext>& decoderContext, const bool outputHost, Crop crop, const Resolution scale,
-    const PixelFormat format, ConstructorLock) noexcept
+    const bool asyncDecode, const bool asyncDemux, const bool seekIndex, const bool mmapInput, const bool cachedInput,
+    const bool fastOpen, const std::shared_ptr<DecoderContext>& decoderContext, const bool outputHost, Crop crop,
+    const Resolution scale, const PixelFormat format, ConstructorLock) noexcept
 {
     // Open the input file
     AVFormatContext* formatPtr = nullptr;
+    if (mmapInput) {
+        // Serve demuxer reads from a memory mapping of the file, falling back to default I/O if it cannot be mapped
+        try {
+            m_mappedIo = make_unique<MappedIo>(fileName);
+        } catch (...) {
+        }
+        if (m_mappedIo.get() == nullptr || !m_mappedIo->isValid()) {
+            logInternal(LogLevel::Warning, "Memory mapped input unavailable, using default file I/O: ", fileName);
+            m_mappedIo.reset();
+        } else {
+            formatPtr = avformat_alloc_context();
+            if (formatPtr == nullptr) {
+                logInternal(LogLevel::Error, "Failed to allocate format context: ", fileName);
+                return;
+            }
+            formatPtr->pb = m_mappedIo->getContext();
+            formatPtr->flags |= AVFMT_FLAG_CUSTOM_IO;
+        }
+    }
+    if (formatPtr == nullptr && cachedInput) {
+        // Serve demuxer reads from a block cache so repeated seeks on slow sources stay off the network
+        try {
+            m_cachedIo = make_unique<CachedIo>(fileName);
+        } catch (...) {
+        }
+        if (m_cachedIo.get() == nullptr || !m_cachedIo->isValid()) {
+            logInternal(LogLevel::Warning, "Cached input unavailable, using default file I/O: ", fileName);
+            m_cachedIo.reset();
+        } else {
+            formatPtr = avformat_alloc_context();
+            if (formatPtr == nullptr) {
+                logInternal(LogLevel::Error, "Failed to allocate format context: ", fileName);
+                return;
+            }
+            formatPtr->pb = m_cachedIo->getContext();
+            formatPtr->flags |= AVFMT_FLAG_CUSTOM_IO;
+        }
+    }
     auto ret = avformat_open_input(&formatPtr, fileName.c_str(), nullptr, nullptr);
     FormatContextPtr tempFormat(formatPtr);
     if (ret < 0) {
@@ -93,7 +170,22 @@ Stream::Stream(const std::string& fileName, uint32_t bufferLength, const uint32_
     }
     bool scaleRequired = (postScale.m_height != 0 || postScale.m_width != 0);
 
+    bool cuvidDecoder = false;
     if (decoderContext.get() != nullptr) {
+        if (decoderContext->getType() == DecodeType::Cuda && (cropRequired || scaleRequired) && !outputHost) {
+            // Keep nvdec hardware accel and crop/scale device frames directly on the GPU
+            m_gpuTransform = true;
+            m_gpuCropLeft = crop.m_left & ~1U; // Round to even for chroma alignment
+            m_gpuCropTop = crop.m_top & ~1U;
+            m_gpuCropWidth = inWidth - m_gpuCropLeft - crop.m_right;
+            m_gpuCropHeight = inHeight - m_gpuCropTop - crop.m_bottom;
+            m_gpuResolution.m_width = postScale.m_width != 0 ? postScale.m_width : m_gpuCropWidth;
+            m_gpuResolution.m_height = postScale.m_height != 0 ? postScale.m_height : m_gpuCropHeight;
+            cropRequired = false;
+            scaleRequired = false;
+            logInternal(LogLevel::Info, "Stream- Using GPU cropping/scaling: ", m_gpuResolution.m_width, ", ",
+                m_gpuResolution.m_height);
+        }
         if (decoderContext->getType() == DecodeType::Cuda && (cropRequired || scaleRequired)) {
             // Use cuvid decoder instead of nvdec hardware accel
             string cuvidName = decoder->name;
@@ -104,6 +196,7 @@ Stream::Stream(const std::string& fileName, uint32_t bufferLength, const uint32_
                 return;
             }
             noBufferFlush = false; // Cant use fast seek with the older cuvid decoder
+            cuvidDecoder = true;
             logInternal(LogLevel::Info, "Stream- Using decoder: cuvid");
         } else {
             // Check if required codec is supported
@@ -173,6 +266,18 @@ Stream::Stream(const std::string& fileName, uint32_t bufferLength, const uint32_
         }
     } else {
         av_dict_set(&opts, "threads", "auto", 0);
+        if ((decoder->capabilities & AV_CODEC_CAP_DR1) != 0) {
+            // Supply decoder frames from a recycled buffer pool to avoid per-frame allocations. Codecs without
+            // direct rendering support must use avcodec_default_get_buffer2 so are left untouched
+            tempCodec->opaque = this;
+            tempCodec->get_buffer2 = &Stream::poolGetBuffer;
+            tempCodec->thread_safe_callbacks = 1;
+        }
+    }
+    // Hardware decoder sessions are a scarce resource so are managed by the decode scheduler. The cuvid decoder
+    // cannot be suspended as its resize/crop options are lost on re-open, and decode-ahead streams are never idle
+    if (decoderContext.get() != nullptr && !cuvidDecoder && !asyncDecode) {
+        m_sessionManaged = DecodeScheduler::get().acquireSession(this);
     }
     ret = avcodec_open2(tempCodec.get(), decoder, &opts);
     if (ret < 0) {
@@ -209,11 +314,34 @@ Stream::Stream(const std::string& fileName, uint32_t bufferLength, const uint32_
     m_outputHost = outputHost && (decoderContext.get() != nullptr);
     m_formatContext = move(tempFormat);
     m_index = index;
+    m_fileName = fileName;
     m_codecContext = move(tempCodec);
+    m_decoderContext = decoderContext;
     m_seekThreshold = seekThreshold;
     m_noBufferFlush = noBufferFlush && (decoderContext.get() != nullptr);
+    m_asyncDecode = asyncDecode;
+    m_asyncDemux = asyncDemux;
+    m_seekIndexEnabled = seekIndex;
     m_frameSeekSupported = m_formatContext->iformat->read_seek2 != nullptr;
 
+#if FFFR_BUILD_CUDA
+    if (m_outputHost && m_decoderContext->getType() == DecodeType::Cuda) {
+        // Create a dedicated stream so host downloads can be issued asynchronously and overlap with decoding
+        auto* const deviceContext = reinterpret_cast<AVHWDeviceContext*>(m_decoderContext->m_deviceContext->data);
+        auto* const cudaDevice = static_cast<AVCUDADeviceContext*>(deviceContext->hwctx);
+        if (cuCtxPushCurrent(cudaDevice->cuda_ctx) == CUDA_SUCCESS) {
+            CUstream transferStream = nullptr;
+            if (cuStreamCreate(&transferStream, CU_STREAM_NON_BLOCKING) == CUDA_SUCCESS) {
+                m_transferStream = transferStream;
+            } else {
+                logInternal(LogLevel::Warning, "Failed to create transfer stream, using synchronous downloads");
+            }
+            CUcontext dummy;
+            cuCtxPopCurrent(&dummy);
+        }
+    }
+#endif
+
     // Ensure ping/pong buffers are long enough to handle the maximum number of frames a video may require
     const uint32_t minFrames = std::max(static_cast<uint32_t>(m_seekThreshold), m_bufferLength);
 
@@ -221,14 +349,40 @@ Stream::Stream(const std::string& fileName, uint32_t bufferLength, const uint32_
     m_bufferPing.reserve(static_cast<size_t>(minFrames) * 2);
     m_bufferPong.reserve(static_cast<size_t>(minFrames) * 2);
 
-    // Determine actual stream start time
-    m_startTimeStamp = getStreamStartTime();
-    m_startTimeStamp2 = timeStampToTimeStamp2(m_startTimeStamp);
+    if (m_asyncDecode) {
+        // The ring must be able to hold the largest possible block while still leaving room to decode ahead
+        if (!m_frameRing.reserve(minFrames * 4)) {
+            logInternal(LogLevel::Warning, "Failed to allocate decode-ahead frame ring, using synchronous decode");
+            m_asyncDecode = false;
+        }
+    }
 
-    // Set stream start time and numbers of frames (done here to ensure correct start timestamp)
-    const auto params = getStreamFramesDuration();
-    m_totalFrames = params.first;
-    m_totalDuration = params.second;
+    // Determine actual stream start time and numbers of frames. These require scanning packets (the whole file for
+    // containers without reliable headers) so a cached sidecar record is used instead when fast open is requested
+    StreamMetadata metadata;
+    if (fastOpen && metadata.load(fileName) && metadata.m_index == m_index) {
+        m_startTimeStamp = metadata.m_startTimeStamp;
+        m_startTimeStamp2 = timeStampToTimeStamp2(m_startTimeStamp);
+        m_totalFrames = metadata.m_totalFrames;
+        m_totalDuration = metadata.m_totalDuration;
+    } else {
+        m_startTimeStamp = getStreamStartTime();
+        m_startTimeStamp2 = timeStampToTimeStamp2(m_startTimeStamp);
+
+        // Set stream start time and numbers of frames (done here to ensure correct start timestamp)
+        const auto params = getStreamFramesDuration();
+        m_totalFrames = params.first;
+        m_totalDuration = params.second;
+
+        if (fastOpen) {
+            // Persist the record so future opens can skip the scans (failure to write is not fatal)
+            metadata.m_index = m_index;
+            metadata.m_startTimeStamp = m_startTimeStamp;
+            metadata.m_totalFrames = m_totalFrames;
+            metadata.m_totalDuration = m_totalDuration;
+            metadata.save(fileName);
+        }
+    }
 
     // Ensure that the stream start at required start time (avoids bogus packets at start of stream)
     av_seek_frame(m_formatContext.get(), m_index, m_startTimeStamp, AVSEEK_FLAG_BACKWARD);
@@ -237,6 +391,36 @@ Stream::Stream(const std::string& fileName, uint32_t bufferLength, const uint32_
         ", seekThreshold=", m_seekThreshold, ", noBufferFlush=", m_noBufferFlush);
 }
 
+Stream::~Stream() noexcept
+{
+    if (m_sessionManaged) {
+        DecodeScheduler::get().releaseSession(this);
+    }
+    if (m_poolDevice != UINT32_MAX) {
+        DecodeScheduler::get().releaseDevice(m_poolDevice);
+    }
+    stopDemuxWorker();
+    stopDecodeWorker();
+#if FFFR_BUILD_CUDA
+    if (m_transferStream != nullptr) {
+        // Wait for any downloads still queued on the transfer stream before releasing their buffers
+        syncTransfers();
+        auto* const deviceContext = reinterpret_cast<AVHWDeviceContext*>(m_decoderContext->m_deviceContext->data);
+        auto* const cudaDevice = static_cast<AVCUDADeviceContext*>(deviceContext->hwctx);
+        if (cuCtxPushCurrent(cudaDevice->cuda_ctx) == CUDA_SUCCESS) {
+            cuStreamDestroy(static_cast<CUstream>(m_transferStream));
+            CUcontext dummy;
+            cuCtxPopCurrent(&dummy);
+        }
+        m_transferStream = nullptr;
+    }
+#endif
+    // Any frames still referencing pooled buffers keep the underlying memory alive
+    av_buffer_pool_uninit(&m_decodeFramePool);
+    av_buffer_pool_uninit(&m_transferFramePool);
+    av_buffer_unref(&m_gpuFramesContext);
+}
+
 bool Stream::initialise() noexcept
 {
     // Decode the first frame (must be done to ensure codec parameters are properly filled)
@@ -269,38 +453,105 @@ bool Stream::initialise() noexcept
     m_totalFrames -= timeStampToFrameNoOffset(m_startTimeStamp);
     m_totalDuration -= timeStampToTimeNoOffset(m_startTimeStamp);
 
+    // Automatic detection starts from the static estimate and then adapts from measured operation costs
+    m_seekThresholdAdaptive = m_seekThreshold == 0;
     m_seekThreshold = frameToTimeStamp2(m_seekThreshold == 0 ? getSeekThreshold() : m_seekThreshold);
     logInternal(LogLevel::Info, "initialise - Using final seek threshold: ", m_seekThreshold);
     return true;
 }
 
+bool Stream::setupSeekIndex(const string& fileName) noexcept
+{
+    // Check for an existing sidecar index before paying for a full packet scan
+    if (m_seekIndex.load(fileName, m_index)) {
+        return true;
+    }
+    logInternal(LogLevel::Info, "Building keyframe seek index for file: ", fileName);
+    AVPacket packet;
+    av_init_packet(&packet);
+    while (av_read_frame(m_formatContext.get(), &packet) >= 0) {
+        if (packet.stream_index == m_index) {
+            const auto timeStamp = getPacketTimeStamp(packet);
+            if (timeStamp != int64_t(AV_NOPTS_VALUE)) {
+                // Record every frame so VFR streams get an exact frame-number mapping
+                m_seekIndex.addFrame(timeStamp);
+                if ((packet.flags & AV_PKT_FLAG_KEY) != 0) {
+                    m_seekIndex.addKeyFrame(timeStamp);
+                }
+            }
+        }
+        av_packet_unref(&packet);
+    }
+    m_seekIndex.setComplete();
+    logInternal(LogLevel::Info, "Built keyframe seek index with keyframes: ", m_seekIndex.getNumKeyFrames());
+    // Return the demuxer to the start of the stream for normal decoding
+    if (av_seek_frame(m_formatContext.get(), m_index, m_startTimeStamp, AVSEEK_FLAG_BACKWARD) < 0) {
+        logInternal(LogLevel::Error, "Failed to reset stream after building seek index: ", fileName);
+        return false;
+    }
+    // Persist the index so future opens can skip the scan (failure to write is not fatal)
+    m_seekIndex.save(fileName, m_index);
+    return true;
+}
+
 shared_ptr<Stream> Stream::getStream(const string& fileName, const DecoderOptions& options) noexcept
 {
     // Create the device context
     shared_ptr<DecoderContext> deviceContext;
+    uint32_t poolDevice = UINT32_MAX;
     if (options.m_type != DecodeType::Software) {
-        deviceContext = make_shared<DecoderContext>(options.m_type, options.m_context, options.m_device);
-        if (deviceContext->m_deviceContext.get() == nullptr) {
-            // Device creation failed
-            return nullptr;
+        if (!options.m_context.has_value()) {
+            // Let the scheduler place the stream on the least loaded device when a device pool is configured
+            deviceContext = DecodeScheduler::get().acquireDevice(options.m_type, poolDevice);
+        }
+        if (deviceContext.get() == nullptr) {
+            deviceContext = make_shared<DecoderContext>(options.m_type, options.m_context, options.m_device);
+            if (deviceContext->m_deviceContext.get() == nullptr) {
+                // Device creation failed
+                return nullptr;
+            }
         }
     }
 
     // Create the new stream
     const bool outputHost = options.m_outputHost && (options.m_type != DecodeType::Software);
-    shared_ptr<Stream> stream =
-        make_shared<Stream>(fileName, options.m_bufferLength, options.m_seekThreshold, options.m_noBufferFlush,
-            deviceContext, outputHost, options.m_crop, options.m_scale, options.m_format, ConstructorLock());
+    shared_ptr<Stream> stream = make_shared<Stream>(fileName, options.m_bufferLength, options.m_seekThreshold,
+        options.m_noBufferFlush, options.m_asyncDecode, options.m_asyncDemux, options.m_seekIndex, options.m_mmapInput,
+        options.m_cachedInput, options.m_fastOpen, deviceContext, outputHost, options.m_crop, options.m_scale,
+        options.m_format, ConstructorLock());
+    // The placement is released by the stream destructor (including on the failure paths below)
+    stream->m_poolDevice = poolDevice;
+    stream->m_openOptions = options;
     if (stream->m_codecContext.get() == nullptr) {
         // Stream creation failed
         return nullptr;
     }
 
+    // Load or build the keyframe index (must be done before any decoding has started)
+    if (stream->m_seekIndexEnabled && !stream->setupSeekIndex(fileName)) {
+        return nullptr;
+    }
+
+    // Apply scrub mode before any frames are decoded on behalf of the caller
+    if (options.m_scrubMode) {
+        stream->setScrubMode(true);
+    }
+
     // Initialise stream data
     if (!stream->initialise()) {
         return nullptr;
     }
 
+    // Start reading packets ahead of the decoder if requested
+    if (stream->m_asyncDemux) {
+        stream->startDemuxWorker();
+    }
+
+    // Start decoding ahead of the reader if requested
+    if (stream->m_asyncDecode) {
+        stream->startDecodeWorker();
+    }
+
     return stream;
 }
 
@@ -309,6 +560,9 @@ uint32_t Stream::getWidth() const noexcept
     if (m_filterGraph.get() != nullptr) {
         return m_filterGraph->getWidth();
     }
+    if (m_gpuTransform) {
+        return m_gpuResolution.m_width;
+    }
     return m_codecContext->width;
 }
 
@@ -317,6 +571,9 @@ uint32_t Stream::getHeight() const noexcept
     if (m_filterGraph.get() != nullptr) {
         return m_filterGraph->getHeight();
     }
+    if (m_gpuTransform) {
+        return m_gpuResolution.m_height;
+    }
     return m_codecContext->height;
 }
 
@@ -354,6 +611,23 @@ uint32_t Stream::getFrameSize() const noexcept
     return av_image_get_buffer_size(StreamUtils::getPixelFormat(this), getWidth(), getHeight(), 32);
 }
 
+void Stream::setScrubMode(const bool scrub) noexcept
+{
+    lock_guard<recursive_mutex> lock(m_mutex);
+    if (scrub == m_scrubMode) {
+        return;
+    }
+    m_scrubMode = scrub;
+    // The decoder discards everything but keyframes, frames already buffered are unaffected
+    m_codecContext->skip_frame = scrub ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+    logInternal(LogLevel::Info, "Scrub mode changed: ", scrub);
+}
+
+bool Stream::getScrubMode() const noexcept
+{
+    return m_scrubMode;
+}
+
 DecodeType Stream::getDecodeType() const noexcept
 {
     if (m_codecContext->pix_fmt == AV_PIX_FMT_CUDA) {
@@ -364,11 +638,22 @@ DecodeType Stream::getDecodeType() const noexcept
 
 shared_ptr<Frame> Stream::peekNextFrame() noexcept
 {
+    if (m_asyncDecode && m_decodeWorker.joinable()) {
+        // Wait-free fast path, only a single reader thread is supported in this mode
+        if (m_bufferPingHead < m_bufferPing.size()) {
+            // Consume any frames decoded before the worker was started
+            return m_bufferPing.at(m_bufferPingHead);
+        }
+        auto frame = m_frameRing.front();
+        if (frame != nullptr) {
+            return frame;
+        }
+        // The worker has not caught up yet (or EOF has been reached)
+        return waitFrameRing();
+    }
     lock_guard<recursive_mutex> lock(m_mutex);
     // Check if we actually have any frames in the current buffer
     if (m_bufferPingHead >= m_bufferPing.size()) {
-        // TODO: Async decode of next block, should start once reached the last couple of frames in a buffer
-        // The swap buffer only should occur when ping buffer is exhausted and pong decode has completed
         if (!decodeNextBlock()) {
             return nullptr;
         }
@@ -384,6 +669,15 @@ shared_ptr<Frame> Stream::peekNextFrame() noexcept
 
 shared_ptr<Frame> Stream::getNextFrame() noexcept
 {
+    if (m_asyncDecode && m_decodeWorker.joinable()) {
+        // Wait-free fast path, only a single reader thread is supported in this mode
+        auto ret = peekNextFrame();
+        if (ret != nullptr) {
+            LOG_DEBUG("getNextFrame- Retrieved frame: ", ret->getTimeStamp());
+            popFrame();
+        }
+        return ret;
+    }
     lock_guard<recursive_mutex> lock(m_mutex);
     auto ret = peekNextFrame();
     if (ret != nullptr) {
@@ -403,9 +697,13 @@ uint32_t Stream::getMaxFrames() noexcept
 vector<std::shared_ptr<Frame>> Stream::getNextFrames(const vector<int64_t>& frameSequence) noexcept
 {
     lock_guard<recursive_mutex> lock(m_mutex);
-    const auto startTime = m_bufferPingHead < m_bufferPing.size() ?
-        m_bufferPing.front()->getTimeStamp() :
-        timeStampToTime2(m_lastDecodedTimeStamp) + frameToTime2(1);
+    auto front = getBufferedFront();
+    if (front == nullptr && m_asyncDecode && m_decodeWorker.joinable()) {
+        // Wait for any in-flight decode-ahead so that the current position is known
+        front = peekNextFrame();
+    }
+    const auto startTime =
+        front != nullptr ? front->getTimeStamp() : timeStampToTime2(m_lastDecodedTimeStamp) + frameToTime2(1);
     vector<int64_t> newSequence;
     generate_n(back_inserter(newSequence), frameSequence.size(),
         [it = frameSequence.begin(), startTime]() mutable { return *(it++) + startTime; });
@@ -416,92 +714,191 @@ vector<shared_ptr<Frame>> Stream::getNextFramesByIndex(const vector<int64_t>& fr
 {
     lock_guard<recursive_mutex> lock(m_mutex);
     vector<shared_ptr<Frame>> ret;
-    const auto startFrame = m_bufferPingHead < m_bufferPing.size() ? m_bufferPing.front()->getFrameNumber() :
-                                                                     timeStampToFrame2(m_lastDecodedTimeStamp) + 1;
+    auto front = getBufferedFront();
+    if (front == nullptr && m_asyncDecode && m_decodeWorker.joinable()) {
+        // Wait for any in-flight decode-ahead so that the current position is known
+        front = peekNextFrame();
+    }
+    const auto startFrame =
+        front != nullptr ? front->getFrameNumber() : timeStampToFrame2(m_lastDecodedTimeStamp) + 1;
     vector<int64_t> newSequence;
     generate_n(back_inserter(newSequence), frameSequence.size(),
         [it = frameSequence.begin(), startFrame]() mutable { return *(it++) + startFrame; });
     return getFramesByIndex(newSequence);
 }
 
+vector<size_t> Stream::planFrameSequence(const vector<int64_t>& frameSequence) noexcept
+{
+    vector<size_t> order;
+    try {
+        order.resize(frameSequence.size());
+        iota(order.begin(), order.end(), size_t{0});
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to allocate frame request plan");
+        return {};
+    }
+    // Processing requests in sorted order turns seek thrashing between clustered requests into a single forward
+    // pass through each GOP, while duplicated requests reuse the already decoded frame
+    stable_sort(order.begin(), order.end(),
+        [&frameSequence](const size_t a, const size_t b) { return frameSequence[a] < frameSequence[b]; });
+    return order;
+}
+
 vector<std::shared_ptr<Frame>> Stream::getFrames(const vector<int64_t>& frameSequence) noexcept
 {
     lock_guard<recursive_mutex> lock(m_mutex);
+    const auto order = planFrameSequence(frameSequence);
     vector<shared_ptr<Frame>> ret;
+    try {
+        ret.resize(frameSequence.size());
+    } catch (...) {
+        return {};
+    }
     const auto bufferBackup = m_bufferLength;
-    for (auto i = frameSequence.cbegin(); i < frameSequence.cend(); ++i) {
+    uint32_t held = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const auto position = order[i];
+        if (i > 0 && frameSequence[position] == frameSequence[order[i - 1]]) {
+            // Duplicated request, reuse the frame decoded for the previous entry
+            ret[position] = ret[order[i - 1]];
+            continue;
+        }
         // Max number of frames that can be reliably held at any point in time is equal to buffer length
-        if (ret.size() >= bufferBackup) {
+        if (held >= bufferBackup) {
             break;
         }
-        if (m_bufferPingHead >= m_bufferPing.size()) {
+        if (getBufferedFront() == nullptr) {
             // Set buffer length based on remaining frames
-            int64_t maxFound = *i;
-            for (auto j = i + 1; j < frameSequence.cend(); ++j) {
-                const auto range = timeToFrame(*j - *i);
-                if (range < m_seekThreshold &&
-                    range < static_cast<int64_t>(bufferBackup) - static_cast<int64_t>(ret.size())) {
-                    maxFound = *j;
+            int64_t maxFound = frameSequence[position];
+            for (size_t j = i + 1; j < order.size(); ++j) {
+                const auto range = timeToFrame(frameSequence[order[j]] - frameSequence[position]);
+                if (range < m_seekThreshold && range < static_cast<int64_t>(bufferBackup) - static_cast<int64_t>(held)) {
+                    maxFound = frameSequence[order[j]];
                 } else {
                     break;
                 }
             }
-            m_bufferLength = std::max(static_cast<uint32_t>(timeToFrame(maxFound - *i)), uint32_t{1});
+            m_bufferLength =
+                std::max(static_cast<uint32_t>(timeToFrame(maxFound - frameSequence[position])), uint32_t{1});
             logInternal(LogLevel::Info, "getFrames- Temporarily increasing buffer length: ", m_bufferLength);
         }
         // Use seek function as that will determine if seek or just a forward decode is needed
-        if (!seek(*i)) {
+        if (!seek(frameSequence[position])) {
             break;
         }
         auto frame = getNextFrame();
         if (frame == nullptr) {
             break;
         }
-        ret.emplace_back(move(frame));
+        ret[position] = move(frame);
+        ++held;
     }
     m_bufferLength = bufferBackup;
+    // Trim to an in-order prefix so a failure part way through looks the same as unplanned sequential retrieval
+    size_t valid = 0;
+    while (valid < ret.size() && ret[valid] != nullptr) {
+        ++valid;
+    }
+    ret.resize(valid);
     return ret;
 }
 
 vector<std::shared_ptr<Frame>> Stream::getFramesByIndex(const vector<int64_t>& frameSequence) noexcept
 {
     lock_guard<recursive_mutex> lock(m_mutex);
+    const auto order = planFrameSequence(frameSequence);
     vector<shared_ptr<Frame>> ret;
+    try {
+        ret.resize(frameSequence.size());
+    } catch (...) {
+        return {};
+    }
     const auto bufferBackup = m_bufferLength;
-    for (auto i = frameSequence.cbegin(); i < frameSequence.cend(); ++i) {
+    uint32_t held = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const auto position = order[i];
+        if (i > 0 && frameSequence[position] == frameSequence[order[i - 1]]) {
+            // Duplicated request, reuse the frame decoded for the previous entry
+            ret[position] = ret[order[i - 1]];
+            continue;
+        }
         // Max number of frames that can be reliable held at any point in time is equal to buffer length
-        if (ret.size() >= bufferBackup) {
+        if (held >= bufferBackup) {
             break;
         }
-        if (m_bufferPingHead >= m_bufferPing.size()) {
+        if (getBufferedFront() == nullptr) {
             // Set buffer length based on remaining frames
-            int64_t maxFound = *i;
-            for (auto j = i + 1; j < frameSequence.cend(); ++j) {
-                const auto range = *j - *i;
-                if (range < m_seekThreshold &&
-                    range < static_cast<int64_t>(bufferBackup) - static_cast<int64_t>(ret.size())) {
-                    maxFound = *j;
+            int64_t maxFound = frameSequence[position];
+            for (size_t j = i + 1; j < order.size(); ++j) {
+                const auto range = frameSequence[order[j]] - frameSequence[position];
+                if (range < m_seekThreshold && range < static_cast<int64_t>(bufferBackup) - static_cast<int64_t>(held)) {
+                    maxFound = frameSequence[order[j]];
                 } else {
                     break;
                 }
             }
-            m_bufferLength = std::max(static_cast<uint32_t>(timeToFrame(maxFound - *i)), uint32_t{1});
+            m_bufferLength =
+                std::max(static_cast<uint32_t>(timeToFrame(maxFound - frameSequence[position])), uint32_t{1});
             LOG_DEBUG("getFramesByIndex- Temporarily increasing buffer length: ", m_bufferLength);
         }
         // Use seek function as that will determine if seek or just a forward decode is needed
-        if (!seekFrame(*i)) {
+        if (!seekFrame(frameSequence[position])) {
             break;
         }
         auto frame = getNextFrame();
         if (frame == nullptr) {
             break;
         }
-        ret.emplace_back(move(frame));
+        ret[position] = move(frame);
+        ++held;
     }
     m_bufferLength = bufferBackup;
+    // Trim to an in-order prefix so a failure part way through looks the same as unplanned sequential retrieval
+    size_t valid = 0;
+    while (valid < ret.size() && ret[valid] != nullptr) {
+        ++valid;
+    }
+    ret.resize(valid);
     return ret;
 }
 
+FramePoolStats Stream::getFramePoolStats() noexcept
+{
+    lock_guard<mutex> lock(m_framePoolMutex);
+    FramePoolStats stats;
+    stats.m_decodeBuffers = m_decodeFramePoolAllocated;
+    stats.m_decodeBufferSize = m_decodeFramePoolSize;
+    stats.m_transferBuffers = m_transferFramePoolAllocated;
+    stats.m_transferBufferSize = m_transferFramePoolSize;
+    return stats;
+}
+
+StreamStats Stream::getStats() const noexcept
+{
+    StreamStats stats;
+    stats.m_packetsDemuxed = m_statPacketsDemuxed.load(memory_order_relaxed);
+    stats.m_framesDecoded = m_statFramesDecoded.load(memory_order_relaxed);
+    stats.m_decodeTime = m_statDecodeTime.load(memory_order_relaxed);
+    stats.m_filterTime = m_statFilterTime.load(memory_order_relaxed);
+    stats.m_transferTime = m_statTransferTime.load(memory_order_relaxed);
+    stats.m_seekCount = m_statSeekCount.load(memory_order_relaxed);
+    for (uint32_t i = 0; i < 4; i++) {
+        stats.m_seekDistances[i] = m_statSeekDistances[i].load(memory_order_relaxed);
+    }
+    stats.m_bufferHighWater = m_statBufferHighWater.load(memory_order_relaxed);
+    const auto lowWater = m_statBufferLowWater.load(memory_order_relaxed);
+    stats.m_bufferLowWater = lowWater == UINT32_MAX ? 0 : lowWater;
+    return stats;
+}
+
+void Stream::recordSeekStats(const int64_t distance) noexcept
+{
+    m_statSeekCount.fetch_add(1, memory_order_relaxed);
+    const auto absDistance = distance >= 0 ? distance : -distance;
+    const uint32_t bucket = absDistance < 16 ? 0 : absDistance < 128 ? 1 : absDistance < 1024 ? 2 : 3;
+    m_statSeekDistances[bucket].fetch_add(1, memory_order_relaxed);
+}
+
 bool Stream::isEndOfFile() const noexcept
 {
     return timeStampToFrame2(m_lastDecodedTimeStamp) + 1 >= getTotalFrames();
@@ -517,11 +914,12 @@ bool Stream::seek(const int64_t timeStamp) noexcept
     lock_guard<recursive_mutex> lock(m_mutex);
     LOG_DEBUG("seek- Seek requested: ", timeStamp);
     // Check if we actually have any frames in the current buffer
-    if (m_bufferPingHead < m_bufferPing.size()) {
+    const auto bufferedFront = getBufferedFront();
+    if (bufferedFront != nullptr) {
         // Check if the frame is in the current buffer
         const auto halfFrameDuration = frameToTime(1) / 2;
-        if ((timeStamp >= m_bufferPing.at(m_bufferPingHead)->getTimeStamp() - halfFrameDuration) &&
-            (timeStamp < m_bufferPing.back()->getTimeStamp() + halfFrameDuration)) {
+        if ((timeStamp >= bufferedFront->getTimeStamp() - halfFrameDuration) &&
+            (timeStamp < getBufferedBack()->getTimeStamp() + halfFrameDuration)) {
             LOG_DEBUG("seek- Frame found already in buffer: ", timeStamp);
             // Dump all frames before requested one
             while (true) {
@@ -553,21 +951,46 @@ bool Stream::seek(const int64_t timeStamp) noexcept
 
             LOG_DEBUG("seek- Using forward decode instead of seek: ", timeStamp);
             // Decode the next block of frames
-            return decodeNextBlock(timeStamp2);
+            if (!m_seekThresholdAdaptive) {
+                return decodeNextBlock(timeStamp2);
+            }
+            const auto start = chrono::steady_clock::now();
+            const auto ret = decodeNextBlock(timeStamp2);
+            updateSeekThreshold(false, timeStampToFrame2(timeStep),
+                chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+            return ret;
         }
     }
 
     // Seek to desired timestamp
     const auto localTimeStamp = timeToTimeStamp(timeStamp);
-    const auto err = avformat_seek_file(m_formatContext.get(), m_index,
-        localTimeStamp - timeStamp2ToTimeStamp(m_seekThreshold), localTimeStamp, localTimeStamp, 0);
+    recordSeekStats(m_lastDecodedTimeStamp != INT64_MIN ? timeStampToFrame2(timeStamp2 - m_lastDecodedTimeStamp) :
+                                                          timeStampToFrame2(timeStamp2));
+    const auto start = chrono::steady_clock::now();
+    syncDemuxWorker();
+    int32_t err;
+    int64_t keyTimeStamp;
+    if (m_seekIndexEnabled && m_seekIndex.findKeyFrame(localTimeStamp, keyTimeStamp)) {
+        // Seek directly to the governing keyframe found in the index
+        LOG_DEBUG("seek- Using indexed keyframe: ", keyTimeStamp, ", ", timeStampToTime(keyTimeStamp));
+        err = avformat_seek_file(m_formatContext.get(), m_index, keyTimeStamp, keyTimeStamp, keyTimeStamp, 0);
+    } else {
+        err = avformat_seek_file(m_formatContext.get(), m_index,
+            localTimeStamp - timeStamp2ToTimeStamp(m_seekThreshold), localTimeStamp, localTimeStamp, 0);
+    }
+    resumeDemuxWorker();
     if (err < 0) {
         logInternal(LogLevel::Error, "Failed seeking to specified time stamp ", timeStamp, getFfmpegErrorString(err));
         return false;
     }
 
     // Decode the next block of frames
-    return decodeNextBlock(timeStamp2, true);
+    const auto ret = decodeNextBlock(timeStamp2, true);
+    if (m_seekThresholdAdaptive && ret) {
+        updateSeekThreshold(
+            true, 0, chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+    }
+    return ret;
 }
 
 bool Stream::seekFrame(const int64_t frame) noexcept
@@ -580,10 +1003,10 @@ bool Stream::seekFrame(const int64_t frame) noexcept
     lock_guard<recursive_mutex> lock(m_mutex);
     LOG_DEBUG("seekFrame- Seek requested: ", frame);
     // Check if we actually have any frames in the current buffer
-    if (m_bufferPingHead < m_bufferPing.size()) {
+    const auto bufferedFront = getBufferedFront();
+    if (bufferedFront != nullptr) {
         // Check if the frame is in the current buffer
-        if ((frame >= m_bufferPing.at(m_bufferPingHead)->getFrameNumber()) &&
-            (frame <= m_bufferPing.back()->getFrameNumber())) {
+        if ((frame >= bufferedFront->getFrameNumber()) && (frame <= getBufferedBack()->getFrameNumber())) {
             LOG_DEBUG("seekFrame- Frame found already in buffer: ", frame);
             // Dump all frames before requested one
             while (true) {
@@ -605,7 +1028,13 @@ bool Stream::seekFrame(const int64_t frame) noexcept
 
     // Check if this is a forward seek within some predefined small range. If so then just continue reading
     // packets from the current position into buffer.
-    const auto timeStamp2 = frameToTimeStamp2(frame);
+    auto timeStamp2 = frameToTimeStamp2(frame);
+    int64_t exactTimeStamp = 0;
+    const bool exactFound = frameToTimeStampExact(frame, exactTimeStamp);
+    if (exactFound) {
+        // Use the exact frame time stamp from the index so VFR streams land on the requested frame first time
+        timeStamp2 = timeStampToTimeStamp2(exactTimeStamp - m_startTimeStamp);
+    }
     if (frame > m_lastDecodedTimeStamp) {
         // Forward decode if within some predefined range of existing point.
         const auto timeStep = timeStamp2 - m_lastDecodedTimeStamp;
@@ -615,8 +1044,40 @@ bool Stream::seekFrame(const int64_t frame) noexcept
 
             LOG_DEBUG("seekFrame- Using forward decode instead of seek: ", frame);
             // Decode the next block of frames
-            return decodeNextBlock(timeStamp2);
+            if (!m_seekThresholdAdaptive) {
+                return decodeNextBlock(timeStamp2);
+            }
+            const auto start = chrono::steady_clock::now();
+            const auto ret = decodeNextBlock(timeStamp2);
+            updateSeekThreshold(false, timeStampToFrame2(timeStep),
+                chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+            return ret;
+        }
+    }
+
+    const auto start = chrono::steady_clock::now();
+    int64_t keyTimeStamp;
+    if (m_seekIndexEnabled &&
+        m_seekIndex.findKeyFrame(exactFound ? exactTimeStamp : frameToTimeStamp(frame), keyTimeStamp)) {
+        // Seek directly to the governing keyframe found in the index
+        LOG_DEBUG("seekFrame- Using indexed keyframe: ", keyTimeStamp, ", ", timeStampToTime(keyTimeStamp));
+        recordSeekStats(m_lastDecodedTimeStamp != INT64_MIN ? frame - timeStampToFrame2(m_lastDecodedTimeStamp) :
+                                                              frame);
+        syncDemuxWorker();
+        const auto err =
+            avformat_seek_file(m_formatContext.get(), m_index, keyTimeStamp, keyTimeStamp, keyTimeStamp, 0);
+        resumeDemuxWorker();
+        if (err < 0) {
+            logInternal(LogLevel::Error, "Failed to seek to specified frame ", frame, ": ", getFfmpegErrorString(err));
+            return false;
+        }
+        // Decode the next block of frames
+        const auto ret = decodeNextBlock(timeStamp2, true);
+        if (m_seekThresholdAdaptive && ret) {
+            updateSeekThreshold(
+                true, 0, chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
         }
+        return ret;
     }
 
     if (!m_frameSeekSupported) {
@@ -626,15 +1087,94 @@ bool Stream::seekFrame(const int64_t frame) noexcept
     }
     // Seek to desired timestamp
     const auto frameInternal = frame + timeStampToFrameNoOffset(m_startTimeStamp);
+    recordSeekStats(m_lastDecodedTimeStamp != INT64_MIN ? frame - timeStampToFrame2(m_lastDecodedTimeStamp) : frame);
+    syncDemuxWorker();
     const auto err = avformat_seek_file(m_formatContext.get(), m_index,
         frameInternal - timeStampToFrame2(m_seekThreshold), frameInternal, frameInternal, AVSEEK_FLAG_FRAME);
+    resumeDemuxWorker();
     if (err < 0) {
         logInternal(LogLevel::Error, "Failed to seek to specified frame ", frame, ": ", getFfmpegErrorString(err));
         return false;
     }
 
     // Decode the next block of frames
-    return decodeNextBlock(timeStamp2, true);
+    const auto ret = decodeNextBlock(timeStamp2, true);
+    if (m_seekThresholdAdaptive && ret) {
+        updateSeekThreshold(
+            true, 0, chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+    }
+    return ret;
+}
+
+/**
+ * Runs an operation on the shared task pool returning a future for its result.
+ * @param func The operation to run.
+ * @returns A future holding the operations result.
+ */
+template<typename F>
+static auto runAsync(F func) -> future<decltype(func())>
+{
+    using Return = decltype(func());
+    // packaged_task is move-only so must be shared to pass through the pools std::function based queue
+    auto task = make_shared<packaged_task<Return()>>(move(func));
+    auto result = task->get_future();
+    if (!TaskPool::get().submit([task] { (*task)(); })) {
+        // Run the operation inline so the returned future is always valid
+        (*task)();
+    }
+    return result;
+}
+
+future<shared_ptr<Frame>> Stream::getNextFrameAsync() noexcept
+{
+    try {
+        // The task holds a reference to the stream so it cannot be destroyed while the operation is outstanding
+        return runAsync([owner = shared_from_this()] { return owner->getNextFrame(); });
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create asynchronous task");
+        return {};
+    }
+}
+
+future<vector<shared_ptr<Frame>>> Stream::getFramesAsync(const vector<int64_t>& frameSequence) noexcept
+{
+    try {
+        return runAsync([owner = shared_from_this(), frameSequence] { return owner->getFrames(frameSequence); });
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create asynchronous task");
+        return {};
+    }
+}
+
+future<vector<shared_ptr<Frame>>> Stream::getFramesByIndexAsync(const vector<int64_t>& frameSequence) noexcept
+{
+    try {
+        return runAsync(
+            [owner = shared_from_this(), frameSequence] { return owner->getFramesByIndex(frameSequence); });
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create asynchronous task");
+        return {};
+    }
+}
+
+future<bool> Stream::seekAsync(const int64_t timeStamp) noexcept
+{
+    try {
+        return runAsync([owner = shared_from_this(), timeStamp] { return owner->seek(timeStamp); });
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create asynchronous task");
+        return {};
+    }
+}
+
+future<bool> Stream::seekFrameAsync(const int64_t frame) noexcept
+{
+    try {
+        return runAsync([owner = shared_from_this(), frame] { return owner->seekFrame(frame); });
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to create asynchronous task");
+        return {};
+    }
 }
 
 int64_t Stream::frameToTime(const int64_t frame) const noexcept
@@ -733,21 +1273,145 @@ int64_t Stream::timeStampToTimeNoOffset(const int64_t timeStamp) const noexcept
     return av_rescale_q(timeStamp, m_formatContext->streams[m_index]->time_base, av_make_q(1, AV_TIME_BASE));
 }
 
-bool Stream::decodeNextBlock(int64_t flushTillTime, bool seeking) noexcept
+bool Stream::frameToTimeStampExact(const int64_t frame, int64_t& timeStamp) const noexcept
 {
-    // TODO: If we are using async decode then this needs to just return if a decode is already running
+    if (!m_seekIndexEnabled) {
+        return false;
+    }
+    return m_seekIndex.findFrameTimeStamp(m_startTimeStamp, frame, timeStamp);
+}
+
+bool Stream::timeStampToFrameExact(const int64_t timeStamp, int64_t& frame) const noexcept
+{
+    if (!m_seekIndexEnabled) {
+        return false;
+    }
+    return m_seekIndex.findFrameNumber(m_startTimeStamp, timeStamp, frame);
+}
+
+bool Stream::decodeNextBlock(const int64_t flushTillTime, const bool seeking) noexcept
+{
+    // Record how empty the buffer was allowed to get before a refill was required
+    lowerWaterMark(m_statBufferLowWater, static_cast<uint32_t>(m_bufferPing.size() - m_bufferPingHead));
+
+    if (m_asyncDecode) {
+        // Any decoded-ahead output pre-dates the requested position so must be discarded
+        syncDecodeWorker();
+    }
 
     // Clean out current buffer and release any frames it may still hold
     m_bufferPing.resize(0);
     m_bufferPingHead = 0;
 
+    const auto statStart = chrono::steady_clock::now();
+    if (!decodeNextBlockPong(flushTillTime, seeking)) {
+        return false;
+    }
+    m_statDecodeTime.fetch_add(
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - statStart).count(),
+        memory_order_relaxed);
+    raiseWaterMark(m_statBufferHighWater, static_cast<uint32_t>(m_bufferPong.size()));
+
+    if (m_asyncDecode && m_decodeWorker.joinable()) {
+        // Publish directly to the frame ring (the ring was just cleared so this cannot block) and start
+        // filling the next block while this one is consumed
+        publishDecodedFrames();
+        requestDecodeAhead();
+        return true;
+    }
+
+    // Swap ping and pong buffer
+    swap(m_bufferPing, m_bufferPong);
+
+    return true;
+}
+
+bool Stream::suspendDecoderSession() noexcept
+{
+    // Called by the decode scheduler with m_mutex held
+    if (!m_sessionManaged || m_suspended || m_codecContext.get() == nullptr) {
+        return false;
+    }
+    // Closing the decoder releases the hardware session. Any buffered frames hold their own references to the
+    // underlying hardware memory so remain valid
+    avcodec_close(m_codecContext.get());
+    m_suspended = true;
+    LOG_DEBUG("suspendDecoderSession- Suspended decoder session: ", m_fileName);
+    return true;
+}
+
+bool Stream::resumeDecoderSession() noexcept
+{
+    if (!DecodeScheduler::get().acquireSession(this)) {
+        return false;
+    }
+    // A closed decoder cannot be re-opened so a fresh context is created in its place
+    CodecContextPtr tempCodec(avcodec_alloc_context3(m_codecContext->codec));
+    if (tempCodec.get() == nullptr) {
+        logInternal(LogLevel::Error, "Failed allocating decoder context: ", m_fileName);
+        DecodeScheduler::get().releaseSession(this);
+        return false;
+    }
+    auto ret = avcodec_parameters_to_context(tempCodec.get(), m_formatContext->streams[m_index]->codecpar);
+    if (ret < 0) {
+        logInternal(LogLevel::Error, "Failed copying parameters to decoder context: ", m_fileName, ", ",
+            getFfmpegErrorString(ret));
+        DecodeScheduler::get().releaseSession(this);
+        return false;
+    }
+    tempCodec->framerate = m_codecContext->framerate;
+    tempCodec->pkt_timebase = m_formatContext->streams[m_index]->time_base;
+    av_opt_set_int(tempCodec.get(), "refcounted_frames", 1, 0);
+    tempCodec->hw_device_ctx = av_buffer_ref(m_decoderContext->m_deviceContext.get());
+    tempCodec->get_format = m_decoderContext->getFormatFunction();
+    tempCodec->extra_hw_frames = static_cast<int32_t>(m_bufferLength + 1);
+    ret = avcodec_open2(tempCodec.get(), tempCodec->codec, nullptr);
+    if (ret < 0) {
+        logInternal(LogLevel::Error, "Failed opening decoder: ", m_fileName, ": ", getFfmpegErrorString(ret));
+        DecodeScheduler::get().releaseSession(this);
+        return false;
+    }
+    m_codecContext = move(tempCodec);
+    m_suspended = false;
+    LOG_DEBUG("resumeDecoderSession- Resumed decoder session: ", m_fileName);
+    return true;
+}
+
+bool Stream::decodeNextBlockPong(int64_t flushTillTime, bool seeking) noexcept
+{
+    if (m_sessionManaged) {
+        if (m_suspended) {
+            if (!resumeDecoderSession()) {
+                return false;
+            }
+            if (!seeking && m_lastDecodedTimeStamp != INT64_MIN) {
+                // Reposition to the governing keyframe so the fresh decoder can rebuild reference state, then
+                // discard everything up to the frame following the suspend point
+                const auto localTimeStamp = timeStamp2ToTimeStamp(m_lastDecodedTimeStamp);
+                syncDemuxWorker();
+                avformat_seek_file(m_formatContext.get(), m_index, INT64_MIN, localTimeStamp, localTimeStamp, 0);
+                resumeDemuxWorker();
+                if (flushTillTime == INT64_MIN) {
+                    flushTillTime = m_lastDecodedTimeStamp + frameToTimeStamp2(1);
+                }
+                seeking = true;
+            }
+            // The fresh decoder must see all packets from the sought keyframe onwards
+            m_lastPacketTimeStamp = INT64_MIN;
+        } else {
+            DecodeScheduler::get().touchSession(this);
+        }
+    }
     // Decode the next buffer sequence
     AVPacket packet;
     av_init_packet(&packet);
     bool eof = false;
     do {
         // This may or may not be a keyframe, So we just start decoding packets until we receive a valid frame
-        auto ret = av_read_frame(m_formatContext.get(), &packet);
+        auto ret = readPacket(&packet);
+        if (ret >= 0) {
+            m_statPacketsDemuxed.fetch_add(1, memory_order_relaxed);
+        }
         bool sentPacket = false;
         if (ret == AVERROR_EOF) {
             eof = true;
@@ -847,12 +1511,301 @@ bool Stream::decodeNextBlock(int64_t flushTillTime, bool seeking) noexcept
             m_bufferPong.pop_back();
         }
     }
-    // Swap ping and pong buffer
-    swap(m_bufferPing, m_bufferPong);
 
     return true;
 }
 
+void Stream::startDecodeWorker() noexcept
+{
+    try {
+        m_decodeWorker = thread(&Stream::decodeWorkerLoop, this);
+    } catch (...) {
+        logInternal(LogLevel::Warning, "Failed to start decode worker thread, using synchronous decode");
+        m_asyncDecode = false;
+        return;
+    }
+    // Prefill the frame ring ahead of the reader
+    requestDecodeAhead();
+}
+
+void Stream::stopDecodeWorker() noexcept
+{
+    if (m_decodeWorker.joinable()) {
+        {
+            lock_guard<mutex> lock(m_workerMutex);
+            m_workerShutdown = true;
+        }
+        m_workerCondition.notify_all();
+        try {
+            m_decodeWorker.join();
+        } catch (...) {
+        }
+    }
+}
+
+void Stream::decodeWorkerLoop() noexcept
+{
+    unique_lock<mutex> lock(m_workerMutex);
+    while (true) {
+        m_workerCondition.wait(lock, [this] { return m_workerRequested.load() || m_workerShutdown; });
+        if (m_workerShutdown) {
+            break;
+        }
+        m_workerRequested = false;
+        m_workerActive = true;
+        lock.unlock();
+        const auto statStart = chrono::steady_clock::now();
+        bool ret = decodeNextBlockPong();
+        if (ret) {
+            m_statDecodeTime.fetch_add(
+                chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - statStart).count(),
+                memory_order_relaxed);
+            raiseWaterMark(m_statBufferHighWater, static_cast<uint32_t>(m_bufferPong.size()));
+        }
+        const bool newFrames = !m_bufferPong.empty();
+        if (ret) {
+            ret = publishDecodedFrames();
+        } else {
+            m_bufferPong.resize(0);
+        }
+        lock.lock();
+        m_workerActive = false;
+        m_workerFailed = !ret && !m_discardBlock;
+        // Keep the ring topped up unless the last block was empty (end of file)
+        if (ret && newFrames && m_frameRing.space() > m_bufferLength) {
+            m_workerRequested = true;
+        }
+        m_workerCondition.notify_all();
+    }
+}
+
+void Stream::startDemuxWorker() noexcept
+{
+    // The ring must hold enough packets to ride out container I/O stalls while the decoder catches up
+    if (!m_packetRing.reserve(64)) {
+        logInternal(LogLevel::Warning, "Failed to allocate demux packet ring, using synchronous demuxing");
+        m_asyncDemux = false;
+        return;
+    }
+    try {
+        m_demuxWorker = thread(&Stream::demuxWorkerLoop, this);
+    } catch (...) {
+        logInternal(LogLevel::Warning, "Failed to start demux worker thread, using synchronous demuxing");
+        m_asyncDemux = false;
+    }
+}
+
+void Stream::stopDemuxWorker() noexcept
+{
+    if (m_demuxWorker.joinable()) {
+        {
+            lock_guard<mutex> lock(m_demuxMutex);
+            m_demuxShutdown = true;
+        }
+        m_demuxCondition.notify_all();
+        try {
+            m_demuxWorker.join();
+        } catch (...) {
+        }
+    }
+}
+
+void Stream::demuxWorkerLoop() noexcept
+{
+    unique_lock<mutex> lock(m_demuxMutex);
+    while (true) {
+        m_demuxCondition.wait(lock, [this] {
+            return m_demuxShutdown ||
+                (!m_demuxPaused && !m_demuxEof && m_demuxError == 0 && m_packetRing.space() != 0);
+        });
+        if (m_demuxShutdown) {
+            break;
+        }
+        m_demuxIdle = false;
+        lock.unlock();
+        // Read the next packet without holding the lock so the consumer is never blocked behind container I/O
+        AVPacket* packet = av_packet_alloc();
+        int32_t ret;
+        if (packet == nullptr) {
+            ret = AVERROR(ENOMEM);
+        } else {
+            ret = av_read_frame(m_formatContext.get(), packet);
+        }
+        lock.lock();
+        if (m_demuxPaused) {
+            // The demuxer was repositioned mid-read so the packet no longer matches the required position
+            av_packet_free(&packet);
+        } else if (ret < 0) {
+            av_packet_free(&packet);
+            if (ret == AVERROR_EOF) {
+                m_demuxEof = true;
+            } else {
+                m_demuxError = ret;
+            }
+        } else {
+            m_packetRing.push(packet);
+        }
+        m_demuxIdle = true;
+        m_demuxCondition.notify_all();
+    }
+}
+
+void Stream::syncDemuxWorker() noexcept
+{
+    if (!m_asyncDemux || !m_demuxWorker.joinable()) {
+        return;
+    }
+    {
+        unique_lock<mutex> lock(m_demuxMutex);
+        // Park the worker and wait out any in-flight read, its output pre-dates the new demuxer position
+        m_demuxPaused = true;
+        m_demuxCondition.notify_all();
+        m_demuxCondition.wait(lock, [this] { return m_demuxIdle; });
+    }
+    if (m_asyncDecode) {
+        // The decode worker consumes from the ring so must also be idle before the ring can be cleared
+        syncDecodeWorker();
+    }
+    lock_guard<mutex> lock(m_demuxMutex);
+    m_packetRing.clear();
+    m_demuxEof = false;
+    m_demuxError = 0;
+}
+
+void Stream::resumeDemuxWorker() noexcept
+{
+    if (!m_asyncDemux || !m_demuxWorker.joinable()) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(m_demuxMutex);
+        m_demuxPaused = false;
+    }
+    m_demuxCondition.notify_all();
+}
+
+int32_t Stream::readPacket(AVPacket* const packet) noexcept
+{
+    if (!m_asyncDemux || !m_demuxWorker.joinable()) {
+        return av_read_frame(m_formatContext.get(), packet);
+    }
+    while (true) {
+        auto* next = m_packetRing.front();
+        if (next != nullptr) {
+            m_packetRing.pop();
+            av_packet_move_ref(packet, next);
+            av_packet_free(&next);
+            // Wake the worker now that there is space in the ring
+            m_demuxCondition.notify_all();
+            return 0;
+        }
+        // The ring is empty, check whether the worker has stopped producing
+        unique_lock<mutex> lock(m_demuxMutex);
+        if (!m_packetRing.empty()) {
+            continue;
+        }
+        if (m_demuxEof || m_demuxShutdown || m_demuxPaused) {
+            // A pause means the demuxer is being repositioned, end the current block as its output is discarded
+            return AVERROR_EOF;
+        }
+        if (m_demuxError != 0) {
+            return m_demuxError;
+        }
+        m_demuxCondition.wait(lock, [this] {
+            return !m_packetRing.empty() || m_demuxEof || m_demuxError != 0 || m_demuxShutdown || m_demuxPaused;
+        });
+    }
+}
+
+bool Stream::publishDecodedFrames() noexcept
+{
+    for (auto& frame : m_bufferPong) {
+        while (m_frameRing.space() == 0) {
+            // Wait for the reader to consume frames before publishing any more
+            unique_lock<mutex> lock(m_workerMutex);
+            m_producerWaiting = true;
+            m_workerCondition.notify_all();
+            m_workerCondition.wait(
+                lock, [this] { return m_frameRing.space() != 0 || m_workerShutdown || m_discardBlock.load(); });
+            m_producerWaiting = false;
+            if (m_workerShutdown || m_discardBlock) {
+                m_bufferPong.resize(0);
+                return false;
+            }
+        }
+        m_frameRing.push(move(frame));
+        if (m_consumerWaiting) {
+            // Wake the reader now instead of when the entire block completes
+            lock_guard<mutex> lock(m_workerMutex);
+            m_workerCondition.notify_all();
+        }
+    }
+    m_bufferPong.resize(0);
+    return true;
+}
+
+void Stream::requestDecodeAhead() noexcept
+{
+    if (!m_decodeWorker.joinable()) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(m_workerMutex);
+        if (m_workerRequested || m_workerActive) {
+            // A block is already queued or being decoded
+            return;
+        }
+        m_workerRequested = true;
+    }
+    m_workerCondition.notify_all();
+}
+
+void Stream::syncDecodeWorker() noexcept
+{
+    unique_lock<mutex> lock(m_workerMutex);
+    m_workerRequested = false;
+    if (m_workerActive) {
+        // Unblock and wait out any in-flight block, its output no longer matches the required position
+        m_discardBlock = true;
+        m_workerCondition.notify_all();
+        m_workerCondition.wait(lock, [this] { return !m_workerActive; });
+        m_discardBlock = false;
+    }
+    m_workerFailed = false;
+    m_bufferPong.resize(0);
+    m_frameRing.clear();
+}
+
+shared_ptr<Frame> Stream::waitFrameRing() noexcept
+{
+    unique_lock<mutex> lock(m_workerMutex);
+    while (m_frameRing.empty()) {
+        if (!m_workerActive && !m_workerRequested) {
+            if (m_workerFailed) {
+                m_workerFailed = false;
+                return nullptr;
+            }
+            // The worker is idle with an empty ring, request the next block (the ring remaining empty after a
+            // completed block means the end of the file has been reached)
+            m_workerRequested = true;
+            m_workerCondition.notify_all();
+        }
+        m_consumerWaiting = true;
+        m_workerCondition.wait(
+            lock, [this] { return !m_frameRing.empty() || (!m_workerActive && !m_workerRequested.load()); });
+        m_consumerWaiting = false;
+        if (m_frameRing.empty() && !m_workerActive && !m_workerRequested) {
+            if (m_workerFailed) {
+                m_workerFailed = false;
+                return nullptr;
+            }
+            logInternal(LogLevel::Warning, "Cannot get a new frame, End of file has been reached");
+            return nullptr;
+        }
+    }
+    return m_frameRing.front();
+}
+
 bool Stream::decodeNextFrames(int64_t& flushTillTime) noexcept
 {
     // Loop through and retrieve all decoded frames
@@ -874,6 +1827,7 @@ bool Stream::decodeNextFrames(int64_t& flushTillTime) noexcept
             logInternal(LogLevel::Error, "Failed to receive decoded frame: ", getFfmpegErrorString(ret));
             return false;
         }
+        m_statFramesDecoded.fetch_add(1, memory_order_relaxed);
 
         // Calculate time stamp for frame
         if (m_tempFrame->best_effort_timestamp == AV_NOPTS_VALUE) {
@@ -961,6 +1915,11 @@ bool Stream::decodeNextFrames(int64_t& flushTillTime) noexcept
 
         auto timeStamp = timeStampToTime2(offsetTimeStamp);
         auto frameNum = timeStampToFrame2(offsetTimeStamp);
+        int64_t exactFrameNum = 0;
+        if (timeStampToFrameExact(timeStamp2ToTimeStamp(offsetTimeStamp + m_startTimeStamp2), exactFrameNum)) {
+            // The index provides the exact frame number which differs from the rational estimate for VFR streams
+            frameNum = exactFrameNum;
+        }
 
         // Update internal timestamps to ensure they are valid
         m_tempFrame->best_effort_timestamp = offsetTimeStamp;
@@ -994,7 +1953,11 @@ bool Stream::processFrames() noexcept
     for (size_t j = 0; j < m_bufferPong.size(); ++j) {
         if (previousTimeStamp != INT64_MIN) {
             // Check for duplicated frames
-            const auto previous = timeStampToFrame2(previousTimeStamp);
+            auto previous = timeStampToFrame2(previousTimeStamp);
+            int64_t exactPrevious = 0;
+            if (timeStampToFrameExact(timeStamp2ToTimeStamp(previousTimeStamp + m_startTimeStamp2), exactPrevious)) {
+                previous = exactPrevious;
+            }
             if (m_bufferPong[j]->getFrameNumber() == previous) {
                 LOG_DEBUG("decodeNextFrames- Deleting duplicated frames: ",
                     m_bufferPong[j]->m_frame->best_effort_timestamp, ", ", m_bufferPong[j]->getTimeStamp());
@@ -1030,12 +1993,46 @@ bool Stream::processFrames() noexcept
         }
     }
 
-    auto it = m_bufferPong.begin();
-    while (it < m_bufferPong.end()) {
-        // Perform any required filtering
-        if (!processFrame(it->get()->m_frame)) {
+    // Perform any required transforms and host downloads
+    for (auto& i : m_bufferPong) {
+        if (!processFrame(i->m_frame)) {
             return false;
         }
+    }
+
+    // Fence the downloads queued for this block in one go before the frames are read or made visible
+    const auto transferStart = chrono::steady_clock::now();
+    if (!syncTransfers()) {
+        return false;
+    }
+    m_statTransferTime.fetch_add(
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - transferStart).count(),
+        memory_order_relaxed);
+
+    if (m_filterGraph != nullptr) {
+        const auto filterStart = chrono::steady_clock::now();
+        // Filter the whole block in a single batch to amortise the per-invocation graph overhead
+        try {
+            vector<FramePtr*> frames;
+            frames.reserve(m_bufferPong.size());
+            for (auto& i : m_bufferPong) {
+                StreamUtils::rescale(
+                    i->m_frame, m_codecContext->time_base, av_buffersink_get_time_base(m_filterGraph->m_sink));
+                frames.emplace_back(&i->m_frame);
+            }
+            if (!m_filterGraph->sendReceiveFrames(frames)) {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+        m_statFilterTime.fetch_add(
+            chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - filterStart).count(),
+            memory_order_relaxed);
+    }
+
+    auto it = m_bufferPong.begin();
+    while (it < m_bufferPong.end()) {
         if (it->get()->m_frame->height != 0) {
             m_lastValidTimeStamp = it->get()->m_frame->best_effort_timestamp;
             ++it;
@@ -1049,52 +2046,135 @@ bool Stream::processFrames() noexcept
     return true;
 }
 
-bool Stream::processFrame(FramePtr& frame) const noexcept
+bool Stream::processFrame(FramePtr& frame) noexcept
 {
-    // Check type of memory pointer requested and perform a memory move
-    if (m_outputHost) {
+    // Apply any GPU resident crop/scale before the frame leaves the device
+    if (m_gpuTransform && frame->hw_frames_ctx != nullptr) {
         const auto timeStamp = frame->best_effort_timestamp;
-        LOG_DEBUG("processFrame- Copying frame to host: ", frame->best_effort_timestamp, ", ",
-            timeStampToTime2(frame->best_effort_timestamp));
+        if (m_gpuFramesContext == nullptr) {
+            // Create a frames context for the transformed output frames on first use
+            auto* framesContext = reinterpret_cast<AVHWFramesContext*>(frame->hw_frames_ctx->data);
+            if (framesContext->sw_format != AV_PIX_FMT_NV12) {
+                av_frame_unref(*frame);
+                logInternal(LogLevel::Error, "GPU cropping/scaling only supports NV12 surfaces");
+                return false;
+            }
+            AVBufferRef* newContext = av_hwframe_ctx_alloc(framesContext->device_ref);
+            if (newContext == nullptr) {
+                av_frame_unref(*frame);
+                logInternal(LogLevel::Error, "Failed to allocate GPU transform frames context");
+                return false;
+            }
+            auto* newFrames = reinterpret_cast<AVHWFramesContext*>(newContext->data);
+            newFrames->format = framesContext->format;
+            newFrames->sw_format = framesContext->sw_format;
+            newFrames->width = static_cast<int32_t>(m_gpuResolution.m_width);
+            newFrames->height = static_cast<int32_t>(m_gpuResolution.m_height);
+            newFrames->initial_pool_size = static_cast<int32_t>(m_bufferLength) + 1;
+            const auto err = av_hwframe_ctx_init(newContext);
+            if (err < 0) {
+                av_buffer_unref(&newContext);
+                av_frame_unref(*frame);
+                logInternal(
+                    LogLevel::Error, "Failed to initialise GPU transform frames context: ", getFfmpegErrorString(err));
+                return false;
+            }
+            m_gpuFramesContext = newContext;
+        }
         FramePtr frame2(av_frame_alloc());
         if (*frame2 == nullptr) {
             av_frame_unref(*frame);
-            logInternal(LogLevel::Error, "Failed to allocate new host frame");
+            logInternal(LogLevel::Error, "Failed to allocate new GPU transform frame");
             return false;
         }
-        const auto ret2 = av_hwframe_transfer_data(*frame2, *frame, 0);
-        av_frame_unref(*frame);
-        if (ret2 < 0) {
-            av_frame_unref(*frame2);
-            logInternal(LogLevel::Error, "Failed to copy frame to host: ", getFfmpegErrorString(ret2));
+        const auto err = av_hwframe_get_buffer(m_gpuFramesContext, *frame2, 0);
+        if (err < 0) {
+            av_frame_unref(*frame);
+            logInternal(LogLevel::Error, "Failed to get GPU transform frame buffer: ", getFfmpegErrorString(err));
+            return false;
+        }
+        if (!gpuCropScaleNV12(*frame, *frame2, m_gpuCropLeft, m_gpuCropTop, m_gpuCropWidth, m_gpuCropHeight)) {
+            av_frame_unref(*frame);
             return false;
         }
+        av_frame_copy_props(*frame2, *frame);
+        av_frame_unref(*frame);
         frame = move(frame2);
-        // Ensure proper timestamps after copy
         frame->best_effort_timestamp = timeStamp;
         frame->pts = timeStamp;
     }
 
-    if (m_filterGraph != nullptr) {
-        StreamUtils::rescale(frame, m_codecContext->time_base, av_buffersink_get_time_base(m_filterGraph->m_sink));
-        if (!m_filterGraph->sendFrame(frame)) {
+    // Check type of memory pointer requested and perform a memory move
+    if (m_outputHost) {
+        const auto transferStart = chrono::steady_clock::now();
+        const auto timeStamp = frame->best_effort_timestamp;
+        LOG_DEBUG("processFrame- Copying frame to host: ", frame->best_effort_timestamp, ", ",
+            timeStampToTime2(frame->best_effort_timestamp));
+        FramePtr frame2(av_frame_alloc());
+        if (*frame2 == nullptr) {
             av_frame_unref(*frame);
+            logInternal(LogLevel::Error, "Failed to allocate new host frame");
             return false;
         }
-        if (!m_filterGraph->receiveFrame(frame)) {
-            av_frame_unref(*frame);
-            return false;
+        // Download into a recycled data buffer, otherwise av_hwframe_transfer_data allocates a fresh one per frame
+        frame2->format = m_codecContext->sw_pix_fmt != AV_PIX_FMT_NONE ? m_codecContext->sw_pix_fmt : frame->format;
+        frame2->width = frame->width;
+        frame2->height = frame->height;
+        bool attached = attachTransferBuffer(*frame2);
+        if (!attached) {
+            // Fall back to letting the transfer allocate its own buffers
+            av_frame_unref(*frame2);
         }
-        // Check if we actually got a new frame or we need to continue
-        if (frame->height == 0) {
-            return true;
+        // Queue the download asynchronously so it overlaps with decoding. The frame is not safe to read until the
+        // transfer stream is fenced, which is done once per decoded block before the frames are filtered or made
+        // visible
+        if (attached && transferFrameAsync(*frame2, *frame)) {
+            av_frame_copy_props(*frame2, *frame);
+            av_frame_unref(*frame);
+        } else {
+            const auto ret2 = av_hwframe_transfer_data(*frame2, *frame, 0);
+            av_frame_unref(*frame);
+            if (ret2 < 0) {
+                av_frame_unref(*frame2);
+                logInternal(LogLevel::Error, "Failed to copy frame to host: ", getFfmpegErrorString(ret2));
+                return false;
+            }
         }
+        frame = move(frame2);
+        // Ensure proper timestamps after copy
+        frame->best_effort_timestamp = timeStamp;
+        frame->pts = timeStamp;
+        m_statTransferTime.fetch_add(
+            chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - transferStart).count(),
+            memory_order_relaxed);
     }
     return true;
 }
 
 void Stream::popFrame() noexcept
 {
+    if (m_asyncDecode && m_decodeWorker.joinable()) {
+        // Wait-free fast path, only a single reader thread is supported in this mode
+        if (m_bufferPingHead < m_bufferPing.size()) {
+            // Consume any frames decoded before the worker was started
+            m_bufferPing.at(m_bufferPingHead++).reset();
+            return;
+        }
+        if (m_frameRing.empty()) {
+            logInternal(LogLevel::Error, "No more frames to pop");
+            return;
+        }
+        m_frameRing.pop();
+        if (m_producerWaiting) {
+            // Wake the worker now that there is space in the ring again
+            m_workerCondition.notify_all();
+        }
+        if (m_frameRing.size() < m_bufferLength && !m_workerRequested) {
+            // Running low on decoded-ahead frames, get the worker to top the ring back up
+            requestDecodeAhead();
+        }
+        return;
+    }
     if (m_bufferPingHead >= m_bufferPing.size()) {
         logInternal(LogLevel::Error, "No more frames to pop");
         return;
@@ -1103,6 +2183,246 @@ void Stream::popFrame() noexcept
     m_bufferPing.at(m_bufferPingHead++).reset();
 }
 
+shared_ptr<Frame> Stream::getBufferedFront() noexcept
+{
+    if (m_bufferPingHead < m_bufferPing.size()) {
+        return m_bufferPing.at(m_bufferPingHead);
+    }
+    if (m_asyncDecode) {
+        return m_frameRing.front();
+    }
+    return nullptr;
+}
+
+shared_ptr<Frame> Stream::getBufferedBack() noexcept
+{
+    if (m_asyncDecode) {
+        auto frame = m_frameRing.back();
+        if (frame != nullptr) {
+            return frame;
+        }
+    }
+    if (m_bufferPingHead < m_bufferPing.size()) {
+        return m_bufferPing.back();
+    }
+    return nullptr;
+}
+
+int32_t Stream::poolGetBuffer(AVCodecContext* context, AVFrame* frame, const int flags) noexcept
+{
+    auto* const stream = static_cast<Stream*>(context->opaque);
+    const auto format = static_cast<AVPixelFormat>(frame->format);
+    // Align the dimensions to match the padding required by the codec
+    int32_t width = frame->width;
+    int32_t height = frame->height;
+    int32_t linesizeAlign[AV_NUM_DATA_POINTERS];
+    avcodec_align_dimensions2(context, &width, &height, linesizeAlign);
+    const auto size = av_image_get_buffer_size(format, width, height, 64);
+    if (size <= 0) {
+        // Unsupported frame type, use the default allocator instead
+        return avcodec_default_get_buffer2(context, frame, flags);
+    }
+    AVBufferRef* buffer;
+    {
+        lock_guard<mutex> lock(stream->m_framePoolMutex);
+        if (stream->m_decodeFramePool == nullptr ||
+            static_cast<uint32_t>(size) + AV_INPUT_BUFFER_PADDING_SIZE > stream->m_decodeFramePoolSize) {
+            // (Re)create the pool to match the required frame size
+            av_buffer_pool_uninit(&stream->m_decodeFramePool);
+            stream->m_decodeFramePool = av_buffer_pool_init2(
+                static_cast<size_t>(size) + AV_INPUT_BUFFER_PADDING_SIZE, stream, &Stream::allocDecodeBuffer, nullptr);
+            stream->m_decodeFramePoolAllocated = 0;
+            if (stream->m_decodeFramePool == nullptr) {
+                stream->m_decodeFramePoolSize = 0;
+                logInternal(LogLevel::Warning, "Failed creating decode frame pool, using default allocator");
+                return avcodec_default_get_buffer2(context, frame, flags);
+            }
+            stream->m_decodeFramePoolSize = static_cast<uint32_t>(size) + AV_INPUT_BUFFER_PADDING_SIZE;
+        }
+        buffer = av_buffer_pool_get(stream->m_decodeFramePool);
+    }
+    if (buffer == nullptr) {
+        return AVERROR(ENOMEM);
+    }
+    if (av_image_fill_arrays(frame->data, frame->linesize, buffer->data, format, width, height, 64) < 0) {
+        av_buffer_unref(&buffer);
+        return avcodec_default_get_buffer2(context, frame, flags);
+    }
+    frame->buf[0] = buffer;
+    frame->extended_data = frame->data;
+    return 0;
+}
+
+bool Stream::attachTransferBuffer(AVFrame* frame) noexcept
+{
+    const auto format = static_cast<AVPixelFormat>(frame->format);
+    const auto size = av_image_get_buffer_size(format, frame->width, frame->height, 64);
+    if (size <= 0) {
+        return false;
+    }
+    AVBufferRef* buffer;
+    {
+        lock_guard<mutex> lock(m_framePoolMutex);
+        if (m_transferFramePool == nullptr || static_cast<uint32_t>(size) > m_transferFramePoolSize) {
+            // (Re)create the pool to match the required frame size
+            av_buffer_pool_uninit(&m_transferFramePool);
+            m_transferFramePool =
+                av_buffer_pool_init2(static_cast<size_t>(size), this, &Stream::allocTransferBuffer, nullptr);
+            m_transferFramePoolAllocated = 0;
+            if (m_transferFramePool == nullptr) {
+                m_transferFramePoolSize = 0;
+                logInternal(LogLevel::Warning, "Failed creating transfer frame pool, using default allocator");
+                return false;
+            }
+            m_transferFramePoolSize = static_cast<uint32_t>(size);
+        }
+        buffer = av_buffer_pool_get(m_transferFramePool);
+    }
+    if (buffer == nullptr) {
+        return false;
+    }
+    if (av_image_fill_arrays(frame->data, frame->linesize, buffer->data, format, frame->width, frame->height, 64) < 0) {
+        av_buffer_unref(&buffer);
+        return false;
+    }
+    frame->buf[0] = buffer;
+    frame->extended_data = frame->data;
+    return true;
+}
+
+AVBufferRef* Stream::allocDecodeBuffer(void* opaque, const int32_t size) noexcept
+{
+    auto* const stream = static_cast<Stream*>(opaque);
+    ++stream->m_decodeFramePoolAllocated;
+    LOG_DEBUG("allocDecodeBuffer- Pool allocating new buffer: ", stream->m_decodeFramePoolAllocated.load());
+    return av_buffer_alloc(size);
+}
+
+AVBufferRef* Stream::allocTransferBuffer(void* opaque, const int32_t size) noexcept
+{
+    auto* const stream = static_cast<Stream*>(opaque);
+    ++stream->m_transferFramePoolAllocated;
+    LOG_DEBUG("allocTransferBuffer- Pool allocating new buffer: ", stream->m_transferFramePoolAllocated.load());
+#if FFFR_BUILD_CUDA
+    if (stream->m_transferStream != nullptr) {
+        // Pinned allocations let downloads run at full copy bandwidth and be issued asynchronously
+        auto* const deviceContext =
+            reinterpret_cast<AVHWDeviceContext*>(stream->m_decoderContext->m_deviceContext->data);
+        auto* const cudaDevice = static_cast<AVCUDADeviceContext*>(deviceContext->hwctx);
+        if (cuCtxPushCurrent(cudaDevice->cuda_ctx) == CUDA_SUCCESS) {
+            void* data = nullptr;
+            const auto err = cuMemHostAlloc(&data, static_cast<size_t>(size), CU_MEMHOSTALLOC_PORTABLE);
+            CUcontext dummy;
+            cuCtxPopCurrent(&dummy);
+            if (err == CUDA_SUCCESS) {
+                // The buffer holds its own device reference as frames may outlive the stream that allocated them
+                auto* const device = av_buffer_ref(stream->m_decoderContext->m_deviceContext.get());
+                if (device != nullptr) {
+                    auto* const buffer = av_buffer_create(
+                        static_cast<uint8_t*>(data), size, &Stream::freePinnedBuffer, device, 0);
+                    if (buffer != nullptr) {
+                        return buffer;
+                    }
+                }
+                freePinnedBuffer(device, static_cast<uint8_t*>(data));
+            }
+        }
+        logInternal(LogLevel::Warning, "Failed to allocate pinned transfer buffer, using pageable memory");
+    }
+#endif
+    return av_buffer_alloc(size);
+}
+
+void Stream::freePinnedBuffer(void* opaque, uint8_t* data) noexcept
+{
+#if FFFR_BUILD_CUDA
+    auto* device = static_cast<AVBufferRef*>(opaque);
+    if (device != nullptr) {
+        auto* const deviceContext = reinterpret_cast<AVHWDeviceContext*>(device->data);
+        auto* const cudaDevice = static_cast<AVCUDADeviceContext*>(deviceContext->hwctx);
+        if (cuCtxPushCurrent(cudaDevice->cuda_ctx) == CUDA_SUCCESS) {
+            cuMemFreeHost(data);
+            CUcontext dummy;
+            cuCtxPopCurrent(&dummy);
+        }
+        av_buffer_unref(&device);
+    }
+#else
+    (void)(opaque);
+    (void)(data);
+#endif
+}
+
+bool Stream::transferFrameAsync(AVFrame* const dest, const AVFrame* const source) noexcept
+{
+#if FFFR_BUILD_CUDA
+    if (m_transferStream == nullptr || source->hw_frames_ctx == nullptr || dest->buf[0] == nullptr) {
+        return false;
+    }
+    auto* const framesContext = reinterpret_cast<AVHWFramesContext*>(source->hw_frames_ctx->data);
+    if (framesContext->device_ctx->type != AV_HWDEVICE_TYPE_CUDA) {
+        return false;
+    }
+    const auto* const descriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(dest->format));
+    if (descriptor == nullptr) {
+        return false;
+    }
+    auto* const cudaDevice = static_cast<AVCUDADeviceContext*>(framesContext->device_ctx->hwctx);
+    if (cuCtxPushCurrent(cudaDevice->cuda_ctx) != CUDA_SUCCESS) {
+        return false;
+    }
+    bool success = true;
+    for (int32_t i = 0; i < AV_NUM_DATA_POINTERS && source->data[i] != nullptr && dest->data[i] != nullptr; i++) {
+        const auto width = av_image_get_linesize(static_cast<AVPixelFormat>(dest->format), dest->width, i);
+        if (width <= 0) {
+            success = false;
+            break;
+        }
+        CUDA_MEMCPY2D copy = {};
+        copy.srcMemoryType = CU_MEMORYTYPE_DEVICE;
+        copy.srcDevice = reinterpret_cast<CUdeviceptr>(source->data[i]);
+        copy.srcPitch = static_cast<size_t>(source->linesize[i]);
+        copy.dstMemoryType = CU_MEMORYTYPE_HOST;
+        copy.dstHost = dest->data[i];
+        copy.dstPitch = static_cast<size_t>(dest->linesize[i]);
+        copy.WidthInBytes = static_cast<size_t>(width);
+        copy.Height = static_cast<size_t>(i == 0 ? dest->height : -(-dest->height >> descriptor->log2_chroma_h));
+        if (cuMemcpy2DAsync(&copy, static_cast<CUstream>(m_transferStream)) != CUDA_SUCCESS) {
+            success = false;
+            break;
+        }
+        m_transferPending = true;
+    }
+    CUcontext dummy;
+    cuCtxPopCurrent(&dummy);
+    if (!success) {
+        // Any planes already queued must complete before the caller falls back to a synchronous copy
+        syncTransfers();
+        return false;
+    }
+    return true;
+#else
+    (void)(dest);
+    (void)(source);
+    return false;
+#endif
+}
+
+bool Stream::syncTransfers() noexcept
+{
+#if FFFR_BUILD_CUDA
+    if (!m_transferPending) {
+        return true;
+    }
+    m_transferPending = false;
+    if (cuStreamSynchronize(static_cast<CUstream>(m_transferStream)) != CUDA_SUCCESS) {
+        logInternal(LogLevel::Error, "Failed to synchronise the transfer stream");
+        return false;
+    }
+#endif
+    return true;
+}
+
 int32_t Stream::getCodecDelay() const noexcept
 {
     return GetCodecDelay(m_codecContext);
@@ -1126,6 +2446,39 @@ int32_t Stream::getSeekThreshold() const noexcept
     return static_cast<int32_t>(frames);
 }
 
+void Stream::updateSeekThreshold(const bool usedSeek, const int64_t frames, const int64_t timeUs) noexcept
+{
+    // Blend new measurements in at a quarter weight so the boundary converges within a few operations without
+    // chasing outliers
+    constexpr float blend = 0.25f;
+    if (usedSeek) {
+        const auto sample = static_cast<float>(timeUs);
+        m_avgSeekTime = m_avgSeekTime == 0.0f ? sample : m_avgSeekTime + blend * (sample - m_avgSeekTime);
+    } else {
+        if (frames <= 0) {
+            return;
+        }
+        const auto sample = static_cast<float>(timeUs) / static_cast<float>(frames);
+        m_avgFrameDecodeTime =
+            m_avgFrameDecodeTime == 0.0f ? sample : m_avgFrameDecodeTime + blend * (sample - m_avgFrameDecodeTime);
+    }
+    if (m_avgSeekTime <= 0.0f || m_avgFrameDecodeTime <= 0.0f) {
+        // Both strategies must have been observed before the decision boundary can be moved
+        return;
+    }
+    // Forward decode is the faster strategy while the frames stepped over cost less than a container seek round trip
+    auto threshold = static_cast<int64_t>(m_avgSeekTime / m_avgFrameDecodeTime);
+    if (m_seekIndexEnabled && m_seekIndex.isComplete() && m_seekIndex.getNumKeyFrames() != 0) {
+        // A container seek still decodes forward from the governing keyframe so the boundary is never below the
+        // observed average keyframe interval
+        threshold = std::max(
+            threshold, static_cast<int64_t>(m_seekIndex.getNumFrames() / m_seekIndex.getNumKeyFrames()));
+    }
+    threshold = std::clamp(threshold, int64_t{2}, int64_t{512});
+    m_seekThreshold = frameToTimeStamp2(threshold);
+    LOG_DEBUG("updateSeekThreshold- Adapted seek threshold to frames: ", threshold);
+}
+
 int32_t Stream::GetCodecDelay(const CodecContextPtr& codec) noexcept
 {
     return std::max((codec->codec->capabilities & AV_CODEC_CAP_DELAY ? codec->delay : 0) + codec->has_b_frames, 1);
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRStreamCache.h"
+
+#include "FFFRUtility.h"
+
+using namespace std;
+
+namespace Ffr {
+StreamCache& StreamCache::get() noexcept
+{
+    static StreamCache cache;
+    return cache;
+}
+
+void StreamCache::setMaxStreams(const uint32_t maxStreams) noexcept
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_maxStreams = maxStreams;
+    while (m_streams.size() > m_maxStreams) {
+        m_streams.pop_back();
+    }
+}
+
+shared_ptr<Stream> StreamCache::getStream(const string& fileName, const DecoderOptions& options) noexcept
+{
+    // Look for an idle stream opened with a matching file and configuration
+    Entry found;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        for (auto i = m_streams.begin(); i != m_streams.end(); ++i) {
+            if (i->m_fileName == fileName && matches(options, i->m_options)) {
+                found = move(*i);
+                m_streams.erase(i);
+                break;
+            }
+        }
+    }
+    if (found.m_stream != nullptr) {
+        // Reset the warm stream back to the start so it behaves like a fresh open. Scrub mode is runtime
+        // toggleable so it is restored to the requested setting rather than matched on
+        if (found.m_stream->getScrubMode() != options.m_scrubMode) {
+            found.m_stream->setScrubMode(options.m_scrubMode);
+        }
+        if (found.m_stream->seekFrame(0)) {
+            return wrapStream(move(found));
+        }
+        // Fall through and open a fresh stream if the reset failed
+        found.m_stream = nullptr;
+    }
+    auto stream = Stream::getStream(fileName, options);
+    if (stream == nullptr) {
+        return nullptr;
+    }
+    Entry entry;
+    try {
+        entry.m_fileName = fileName;
+        entry.m_options = options;
+    } catch (...) {
+        // The stream is still usable, it just cannot be returned to the cache
+        return stream;
+    }
+    entry.m_stream = move(stream);
+    return wrapStream(move(entry));
+}
+
+void StreamCache::clear() noexcept
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_streams.clear();
+}
+
+bool StreamCache::matches(const DecoderOptions& options, const DecoderOptions& other) noexcept
+{
+    // The base comparison covers the decode type, buffer length, device and hardware context
+    if (options != other) {
+        return false;
+    }
+    return options.m_crop.m_top == other.m_crop.m_top && options.m_crop.m_bottom == other.m_crop.m_bottom &&
+        options.m_crop.m_left == other.m_crop.m_left && options.m_crop.m_right == other.m_crop.m_right &&
+        options.m_scale.m_width == other.m_scale.m_width && options.m_scale.m_height == other.m_scale.m_height &&
+        options.m_format == other.m_format && options.m_seekThreshold == other.m_seekThreshold &&
+        options.m_noBufferFlush == other.m_noBufferFlush && options.m_outputHost == other.m_outputHost &&
+        options.m_asyncDecode == other.m_asyncDecode && options.m_asyncDemux == other.m_asyncDemux &&
+        options.m_seekIndex == other.m_seekIndex && options.m_mmapInput == other.m_mmapInput &&
+        options.m_cachedInput == other.m_cachedInput;
+}
+
+shared_ptr<Stream> StreamCache::wrapStream(Entry entry) noexcept
+{
+    try {
+        auto* const stream = entry.m_stream.get();
+        // The wrapper keeps the stream alive through the entry and hands it back to the cache on release
+        return shared_ptr<Stream>(stream, [entry = move(entry)](Stream*) mutable noexcept {
+            StreamCache::get().returnStream(move(entry));
+        });
+    } catch (...) {
+        logInternal(LogLevel::Warning, "Failed to attach stream to cache, it will be closed on release");
+        return move(entry.m_stream);
+    }
+}
+
+void StreamCache::returnStream(Entry&& entry) noexcept
+{
+    try {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_maxStreams == 0) {
+            return;
+        }
+        m_streams.emplace_front(move(entry));
+        while (m_streams.size() > m_maxStreams) {
+            m_streams.pop_back();
+        }
+    } catch (...) {
+        // The stream is simply closed if it cannot be cached
+    }
+}
+} // namespace Ffr
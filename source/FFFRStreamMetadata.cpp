@@ -0,0 +1,124 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRStreamMetadata.h"
+
+#include "FFFRUtility.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace std;
+
+namespace Ffr {
+/** Magic number and layout version identifying a sidecar metadata file */
+constexpr uint64_t g_metadataMagic = 0x5846464952415445ULL; /* "ETARIFFX" */
+constexpr uint32_t g_metadataVersion = 1;
+
+bool StreamMetadata::load(const std::string& fileName) noexcept
+{
+    try {
+        ifstream file(getSidecarFileName(fileName), ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        uint64_t magic = 0;
+        uint32_t version = 0;
+        uint64_t size = 0;
+        int64_t modified = 0;
+        StreamMetadata loaded;
+        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&size), sizeof(size));
+        file.read(reinterpret_cast<char*>(&modified), sizeof(modified));
+        file.read(reinterpret_cast<char*>(&loaded.m_index), sizeof(loaded.m_index));
+        file.read(reinterpret_cast<char*>(&loaded.m_startTimeStamp), sizeof(loaded.m_startTimeStamp));
+        file.read(reinterpret_cast<char*>(&loaded.m_totalFrames), sizeof(loaded.m_totalFrames));
+        file.read(reinterpret_cast<char*>(&loaded.m_totalDuration), sizeof(loaded.m_totalDuration));
+        if (!file.good() || magic != g_metadataMagic || version != g_metadataVersion) {
+            return false;
+        }
+        // Reject the sidecar if the source file has changed since the record was written
+        uint64_t currentSize = 0;
+        int64_t currentModified = 0;
+        if (!getFileSignature(fileName, currentSize, currentModified) || currentSize != size ||
+            currentModified != modified) {
+            logInternal(LogLevel::Info, "Ignoring stale metadata sidecar for file: ", fileName);
+            return false;
+        }
+        *this = loaded;
+        logInternal(LogLevel::Info, "Loaded metadata sidecar with total frames: ", m_totalFrames);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool StreamMetadata::save(const std::string& fileName) const noexcept
+{
+    try {
+        uint64_t size = 0;
+        int64_t modified = 0;
+        if (!getFileSignature(fileName, size, modified)) {
+            return false;
+        }
+        ofstream file(getSidecarFileName(fileName), ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            logInternal(LogLevel::Warning, "Failed to create metadata sidecar for file: ", fileName);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&g_metadataMagic), sizeof(g_metadataMagic));
+        file.write(reinterpret_cast<const char*>(&g_metadataVersion), sizeof(g_metadataVersion));
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char*>(&modified), sizeof(modified));
+        file.write(reinterpret_cast<const char*>(&m_index), sizeof(m_index));
+        file.write(reinterpret_cast<const char*>(&m_startTimeStamp), sizeof(m_startTimeStamp));
+        file.write(reinterpret_cast<const char*>(&m_totalFrames), sizeof(m_totalFrames));
+        file.write(reinterpret_cast<const char*>(&m_totalDuration), sizeof(m_totalDuration));
+        return file.good();
+    } catch (...) {
+        return false;
+    }
+}
+
+string StreamMetadata::getSidecarFileName(const std::string& fileName) noexcept
+{
+    try {
+        return fileName + ".ffmeta";
+    } catch (...) {
+        return {};
+    }
+}
+
+bool StreamMetadata::getFileSignature(const std::string& fileName, uint64_t& size, int64_t& modified) noexcept
+{
+    try {
+        error_code error;
+        const auto fileSize = filesystem::file_size(fileName, error);
+        if (error) {
+            return false;
+        }
+        const auto fileTime = filesystem::last_write_time(fileName, error);
+        if (error) {
+            return false;
+        }
+        size = static_cast<uint64_t>(fileSize);
+        modified = static_cast<int64_t>(fileTime.time_since_epoch().count());
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+} // namespace Ffr
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRTaskPool.h"
+
+#include "FFFRUtility.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace Ffr {
+TaskPool& TaskPool::get() noexcept
+{
+    static TaskPool pool;
+    return pool;
+}
+
+TaskPool::~TaskPool() noexcept
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+        try {
+            worker.join();
+        } catch (...) {
+        }
+    }
+}
+
+void TaskPool::setNumThreads(const uint32_t numThreads) noexcept
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (!m_workers.empty()) {
+        logInternal(LogLevel::Warning, "Task pool size cannot be changed once the pool has started");
+        return;
+    }
+    m_numThreads = numThreads;
+}
+
+bool TaskPool::submit(function<void()> task) noexcept
+{
+    try {
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (m_shutdown) {
+                return false;
+            }
+            if (m_workers.empty()) {
+                // Start the pool on first use
+                const auto numThreads =
+                    m_numThreads != 0 ? m_numThreads : std::max(thread::hardware_concurrency(), 1u);
+                m_workers.reserve(numThreads);
+                for (uint32_t i = 0; i < numThreads; i++) {
+                    m_workers.emplace_back(&TaskPool::workerLoop, this);
+                }
+            }
+            m_tasks.emplace_back(move(task));
+        }
+        m_condition.notify_one();
+        return true;
+    } catch (...) {
+        logInternal(LogLevel::Error, "Failed to queue asynchronous task");
+        return false;
+    }
+}
+
+void TaskPool::workerLoop() noexcept
+{
+    unique_lock<mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return !m_tasks.empty() || m_shutdown; });
+        if (m_shutdown) {
+            break;
+        }
+        auto task = move(m_tasks.front());
+        m_tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+} // namespace Ffr
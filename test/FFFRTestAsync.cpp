@@ -0,0 +1,182 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRTestData.h"
+#include "FFFrameReader.h"
+
+#include <gtest/gtest.h>
+
+using namespace Ffr;
+
+class AsyncTest1 : public ::testing::TestWithParam<TestParams>
+{
+protected:
+    AsyncTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+        DecoderOptions options;
+        options.m_asyncDecode = true;
+        m_stream = Stream::getStream(GetParam().m_fileName, options);
+        ASSERT_NE(m_stream, nullptr);
+        m_streamSync = Stream::getStream(GetParam().m_fileName);
+        ASSERT_NE(m_streamSync, nullptr);
+    }
+
+    void TearDown() override
+    {
+        m_stream.reset();
+        m_streamSync.reset();
+    }
+
+    std::shared_ptr<Stream> m_stream = nullptr;
+    std::shared_ptr<Stream> m_streamSync = nullptr;
+};
+
+TEST_P(AsyncTest1, getNextFrame)
+{
+    // Check that asynchronous decode returns the exact same frame sequence as synchronous decode
+    constexpr uint32_t numFrames = 35;
+    for (uint32_t i = 0; i < numFrames; i++) {
+        const auto frame1 = m_stream->getNextFrame();
+        const auto frame2 = m_streamSync->getNextFrame();
+        ASSERT_NE(frame1, nullptr);
+        ASSERT_NE(frame2, nullptr);
+        ASSERT_EQ(frame1->getTimeStamp(), frame2->getTimeStamp());
+        ASSERT_EQ(frame1->getFrameNumber(), frame2->getFrameNumber());
+    }
+}
+
+TEST_P(AsyncTest1, seek)
+{
+    constexpr int64_t seekFrames = 80;
+    const int64_t actualSeek =
+        seekFrames >= GetParam().m_totalFrames ? GetParam().m_totalFrames - 5 : seekFrames;
+    const auto time1 = m_stream->frameToTime(actualSeek);
+    ASSERT_TRUE(m_stream->seek(time1));
+    const auto frame1 = m_stream->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getTimeStamp(), time1);
+    // Check that decode-ahead continues correctly after the seek
+    const auto frame2 = m_stream->getNextFrame();
+    ASSERT_NE(frame2, nullptr);
+    ASSERT_EQ(frame2->getFrameNumber(), frame1->getFrameNumber() + 1);
+}
+
+TEST_P(AsyncTest1, endOfFile)
+{
+    ASSERT_TRUE(m_stream->seekFrame(GetParam().m_totalFrames - 3));
+    for (int64_t i = 0; i < 3; i++) {
+        ASSERT_NE(m_stream->getNextFrame(), nullptr);
+    }
+    ASSERT_EQ(m_stream->getNextFrame(), nullptr);
+    ASSERT_TRUE(m_stream->isEndOfFile());
+}
+
+TEST_P(AsyncTest1, getNextFrameFuture)
+{
+    // Check that futures resolved on the shared task pool return the expected frame sequence
+    constexpr uint32_t numFrames = 10;
+    for (uint32_t i = 0; i < numFrames; i++) {
+        auto result = m_streamSync->getNextFrameAsync();
+        ASSERT_TRUE(result.valid());
+        const auto frame1 = result.get();
+        ASSERT_NE(frame1, nullptr);
+        ASSERT_EQ(frame1->getFrameNumber(), i);
+    }
+}
+
+TEST_P(AsyncTest1, seekFuture)
+{
+    constexpr int64_t seekFrames = 40;
+    const int64_t actualSeek =
+        seekFrames >= GetParam().m_totalFrames ? GetParam().m_totalFrames - 5 : seekFrames;
+    auto result = m_streamSync->seekFrameAsync(actualSeek);
+    ASSERT_TRUE(result.valid());
+    ASSERT_TRUE(result.get());
+    const auto frame1 = m_streamSync->getNextFrameAsync().get();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getFrameNumber(), actualSeek);
+}
+
+class AsyncDemuxTest1 : public ::testing::TestWithParam<TestParams>
+{
+protected:
+    AsyncDemuxTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+        DecoderOptions options;
+        options.m_asyncDemux = true;
+        m_stream = Stream::getStream(GetParam().m_fileName, options);
+        ASSERT_NE(m_stream, nullptr);
+        m_streamSync = Stream::getStream(GetParam().m_fileName);
+        ASSERT_NE(m_streamSync, nullptr);
+    }
+
+    void TearDown() override
+    {
+        m_stream.reset();
+        m_streamSync.reset();
+    }
+
+    std::shared_ptr<Stream> m_stream = nullptr;
+    std::shared_ptr<Stream> m_streamSync = nullptr;
+};
+
+TEST_P(AsyncDemuxTest1, getNextFrame)
+{
+    // Check that asynchronous demuxing returns the exact same frame sequence as synchronous demuxing
+    constexpr uint32_t numFrames = 35;
+    for (uint32_t i = 0; i < numFrames; i++) {
+        const auto frame1 = m_stream->getNextFrame();
+        const auto frame2 = m_streamSync->getNextFrame();
+        ASSERT_NE(frame1, nullptr);
+        ASSERT_NE(frame2, nullptr);
+        ASSERT_EQ(frame1->getTimeStamp(), frame2->getTimeStamp());
+        ASSERT_EQ(frame1->getFrameNumber(), frame2->getFrameNumber());
+    }
+}
+
+TEST_P(AsyncDemuxTest1, seek)
+{
+    constexpr int64_t seekFrames = 80;
+    const int64_t actualSeek =
+        seekFrames >= GetParam().m_totalFrames ? GetParam().m_totalFrames - 5 : seekFrames;
+    const auto time1 = m_stream->frameToTime(actualSeek);
+    ASSERT_TRUE(m_stream->seek(time1));
+    const auto frame1 = m_stream->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getTimeStamp(), time1);
+    // Check that packet read-ahead continues correctly after the seek
+    const auto frame2 = m_stream->getNextFrame();
+    ASSERT_NE(frame2, nullptr);
+    ASSERT_EQ(frame2->getFrameNumber(), frame1->getFrameNumber() + 1);
+}
+
+TEST_P(AsyncDemuxTest1, endOfFile)
+{
+    ASSERT_TRUE(m_stream->seekFrame(GetParam().m_totalFrames - 3));
+    for (int64_t i = 0; i < 3; i++) {
+        ASSERT_NE(m_stream->getNextFrame(), nullptr);
+    }
+    ASSERT_EQ(m_stream->getNextFrame(), nullptr);
+    ASSERT_TRUE(m_stream->isEndOfFile());
+}
+
+INSTANTIATE_TEST_SUITE_P(AsyncTestData, AsyncTest1, ::testing::ValuesIn(g_testData));
+INSTANTIATE_TEST_SUITE_P(AsyncDemuxTestData, AsyncDemuxTest1, ::testing::ValuesIn(g_testData));
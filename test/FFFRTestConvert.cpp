@@ -181,5 +181,77 @@ TEST_P(ConvertTest1, convert)
     }
 }
 
+TEST_P(ConvertTest1, convertBatch)
+{
+    if (GetParam().m_format != PixelFormat::RGB8P && GetParam().m_format != PixelFormat::RGB32FP) {
+        return;
+    }
+    constexpr uint32_t batchSize = 3;
+    std::vector<std::shared_ptr<Frame>> frames;
+    for (uint32_t j = 0; j < batchSize; j++) {
+        auto frame1 = m_decoder.m_stream->getNextFrame();
+        ASSERT_NE(frame1, nullptr);
+        frames.emplace_back(std::move(frame1));
+    }
+
+    // Allocate memory large enough for the whole batch
+    const auto width = frames.front()->getWidth();
+    const auto height = frames.front()->getHeight();
+    const auto frameSize = getImageSize(GetParam().m_format, width, height);
+    CUdeviceptr batchBuffer = reinterpret_cast<CUdeviceptr>(nullptr);
+    ASSERT_EQ(cuCtxPushCurrent(m_decoder.m_context.get()), CUDA_SUCCESS);
+    ASSERT_EQ(cuMemAlloc(&batchBuffer, static_cast<size_t>(frameSize) * batchSize), CUDA_SUCCESS);
+    CUcontext dummy;
+    ASSERT_EQ(cuCtxPopCurrent(&dummy), CUDA_SUCCESS);
+
+    // All conversions should be performed with a single fence
+    ASSERT_TRUE(convertFormatBatch(frames, reinterpret_cast<uint8_t*>(batchBuffer), GetParam().m_format));
+
+    ASSERT_EQ(cuCtxPushCurrent(m_decoder.m_context.get()), CUDA_SUCCESS);
+    ASSERT_EQ(cuMemFree(batchBuffer), CUDA_SUCCESS);
+    ASSERT_EQ(cuCtxPopCurrent(&dummy), CUDA_SUCCESS);
+}
+
+TEST_P(ConvertTest1, preProcess)
+{
+    if (GetParam().m_format != PixelFormat::RGB32FP) {
+        return;
+    }
+    const auto frame1 = m_decoder.m_stream->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+
+    PreProcessParams params;
+    params.m_crop = {10, 10, 16, 16};
+    params.m_scale = {224, 224};
+    params.m_mean[0] = 0.485f, params.m_mean[1] = 0.456f, params.m_mean[2] = 0.406f;
+    params.m_std[0] = 0.229f, params.m_std[1] = 0.224f, params.m_std[2] = 0.225f;
+
+    // Allocate memory for the output tensor
+    const auto tensorSize = static_cast<size_t>(params.m_scale.m_width) * params.m_scale.m_height * 3 * sizeof(float);
+    CUdeviceptr tensorBuffer = reinterpret_cast<CUdeviceptr>(nullptr);
+    ASSERT_EQ(cuCtxPushCurrent(m_decoder.m_context.get()), CUDA_SUCCESS);
+    ASSERT_EQ(cuMemAlloc(&tensorBuffer, tensorSize), CUDA_SUCCESS);
+    CUcontext dummy;
+    ASSERT_EQ(cuCtxPopCurrent(&dummy), CUDA_SUCCESS);
+
+    ASSERT_TRUE(preProcessFrame(frame1, reinterpret_cast<uint8_t*>(tensorBuffer), params));
+
+    // Verify the output values lie within the normalised range
+    std::vector<float> hostTensor(tensorSize / sizeof(float));
+    ASSERT_EQ(cuCtxPushCurrent(m_decoder.m_context.get()), CUDA_SUCCESS);
+    ASSERT_EQ(cuMemcpyDtoH(hostTensor.data(), tensorBuffer, tensorSize), CUDA_SUCCESS);
+    ASSERT_EQ(cuMemFree(tensorBuffer), CUDA_SUCCESS);
+    ASSERT_EQ(cuCtxPopCurrent(&dummy), CUDA_SUCCESS);
+    for (uint32_t j = 0; j < 3; j++) {
+        const auto low = (0.0f - params.m_mean[j]) / params.m_std[j];
+        const auto high = (1.0f - params.m_mean[j]) / params.m_std[j];
+        const auto* plane = &hostTensor[static_cast<size_t>(j) * params.m_scale.m_width * params.m_scale.m_height];
+        for (uint32_t i = 0; i < params.m_scale.m_width * params.m_scale.m_height; i++) {
+            ASSERT_GE(plane[i], low);
+            ASSERT_LE(plane[i], high);
+        }
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(ConvertTestData, ConvertTest1, ::testing::ValuesIn(g_testDataConvert));
 #endif
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRTestData.h"
+#include "FFFRUtility.h"
+#include "FFFrameReader.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C" {
+#include <libavutil/imgutils.h>
+}
+
+using namespace Ffr;
+
+extern void saveImage(PixelFormat format, uint32_t width, uint32_t height, const std::string& filename,
+    uint8_t* buffer[4], int32_t step[4]) noexcept;
+
+struct TestParamsConvertHost
+{
+    uint32_t m_testDataIndex;
+    PixelFormat m_format;
+    std::string m_imageFile;
+};
+
+static std::vector<TestParamsConvertHost> g_testDataConvertHost = {
+    {1, PixelFormat::RGB8P, "test-converthost-1"},
+    {1, PixelFormat::RGB32FP, "test-converthost-2"},
+    {3, PixelFormat::RGB8P, "test-converthost-3"},
+    {3, PixelFormat::RGB32FP, "test-converthost-4"},
+};
+
+class ConvertHostTest1 : public ::testing::TestWithParam<TestParamsConvertHost>
+{
+protected:
+    ConvertHostTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+        DecoderOptions options;
+        options.m_bufferLength = 1;
+        m_stream = Stream::getStream(g_testData[GetParam().m_testDataIndex].m_fileName, options);
+        ASSERT_NE(m_stream, nullptr);
+
+        // Allocate new memory to store frame data
+        const auto width = m_stream->peekNextFrame()->getWidth();
+        const auto height = m_stream->peekNextFrame()->getHeight();
+        const auto outFrameSize = getImageSize(GetParam().m_format, width, height) +
+            getImagePlaneStep(GetParam().m_format, width, height, 0); // extra added to test for stomping
+        m_buffer.resize(outFrameSize, 254);
+    }
+
+    void TearDown() override
+    {
+        m_stream.reset();
+    }
+
+    std::shared_ptr<Stream> m_stream = nullptr;
+    std::vector<uint8_t> m_buffer;
+};
+
+TEST_P(ConvertHostTest1, convert)
+{
+    for (uint32_t j = 0; j < 3; j++) {
+        const auto frame1 = m_stream->getNextFrame();
+        ASSERT_NE(frame1, nullptr);
+        ASSERT_EQ(frame1->getDataType(), DecodeType::Software);
+
+        // Check if known pixel format
+        ASSERT_NE(frame1->getPixelFormat(), Ffr::PixelFormat::Auto);
+
+        // Convert image data into output using the host kernels
+        ASSERT_TRUE(convertFormat(frame1, m_buffer.data(), GetParam().m_format));
+
+        // Save to image for visual inspection
+        const auto width = frame1->getWidth();
+        const auto height = frame1->getHeight();
+        uint8_t* outPlanes[4];
+        int32_t outStep[4];
+        av_image_fill_arrays(
+            outPlanes, outStep, m_buffer.data(), getPixelFormat(GetParam().m_format), width, height, 32);
+        ::saveImage(
+            GetParam().m_format, width, height, GetParam().m_imageFile + "-" + std::to_string(j), outPlanes, outStep);
+
+        // Check for memory stomping
+        const auto padding = getImagePlaneStep(GetParam().m_format, width, height, 0);
+        const auto imageSize = getImageSize(GetParam().m_format, width, height) + padding;
+        for (int32_t i = 0; i < padding; i++) {
+            ASSERT_EQ(m_buffer[imageSize - padding + i], 254);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ConvertHostTestData, ConvertHostTest1, ::testing::ValuesIn(g_testDataConvertHost));
@@ -218,6 +218,93 @@ TEST_P(DecodeTest1, getMultiple)
     ASSERT_EQ(frame3->getTimeStamp(), 0);
 }
 
+TEST_P(DecodeTest1, getDevicePool)
+{
+    if (!GetParam().m_useNvdec || GetParam().m_useContext) {
+        return;
+    }
+    // Streams opened while a pool is configured are automatically placed on its least loaded device
+    setDecodeDevicePool({0});
+    TestDecoder test2;
+    test2.SetUp(GetParam());
+    const auto frame1 = test2.m_stream->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getTimeStamp(), 0);
+    setDecodeDevicePool({});
+}
+
+TEST_P(DecodeTest1, getMultipleLimitedSessions)
+{
+    if (!GetParam().m_useNvdec) {
+        return;
+    }
+    // Force the three streams to share two decoder sessions so they are time-sliced by the scheduler
+    setMaxDecodeSessions(2);
+    TestDecoder test2;
+    test2.SetUp(GetParam());
+    TestDecoder test3;
+    test3.SetUp(GetParam());
+    // Interleave reads so each stream is repeatedly suspended and resumed
+    int64_t frameNum = 0;
+    for (uint32_t i = 0; i < 5; i++) {
+        const auto frame1 = m_decoder.m_stream->getNextFrame();
+        ASSERT_NE(frame1, nullptr);
+        ASSERT_EQ(frame1->getFrameNumber(), frameNum);
+        const auto frame2 = test2.m_stream->getNextFrame();
+        ASSERT_NE(frame2, nullptr);
+        ASSERT_EQ(frame2->getFrameNumber(), frameNum);
+        const auto frame3 = test3.m_stream->getNextFrame();
+        ASSERT_NE(frame3, nullptr);
+        ASSERT_EQ(frame3->getFrameNumber(), frameNum);
+        ++frameNum;
+    }
+    setMaxDecodeSessions(0);
+}
+
+TEST_P(DecodeTest1, getMemoryMappedInput)
+{
+    if (GetParam().m_useNvdec) {
+        return;
+    }
+    // Check that reading through a memory mapped input returns the same frames as default I/O
+    DecoderOptions options;
+    options.m_mmapInput = true;
+    const auto stream = Stream::getStream(g_testData[GetParam().m_testDataIndex].m_fileName, options);
+    ASSERT_NE(stream, nullptr);
+    const auto frame1 = stream->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getTimeStamp(), 0);
+    if (g_testData[GetParam().m_testDataIndex].m_totalFrames > 25) {
+        ASSERT_TRUE(stream->seekFrame(25));
+        const auto frame2 = stream->getNextFrame();
+        ASSERT_NE(frame2, nullptr);
+        ASSERT_EQ(frame2->getFrameNumber(), 25);
+    }
+}
+
+TEST_P(DecodeTest1, getCachedInput)
+{
+    if (GetParam().m_useNvdec) {
+        return;
+    }
+    // Check that reading through the block cached I/O layer returns the same frames as default I/O
+    DecoderOptions options;
+    options.m_cachedInput = true;
+    const auto stream = Stream::getStream(g_testData[GetParam().m_testDataIndex].m_fileName, options);
+    ASSERT_NE(stream, nullptr);
+    const auto frame1 = stream->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getTimeStamp(), 0);
+    if (g_testData[GetParam().m_testDataIndex].m_totalFrames > 25) {
+        // A backward seek after forward reads must be served from the cache correctly
+        ASSERT_TRUE(stream->seekFrame(25));
+        ASSERT_TRUE(stream->seekFrame(5));
+        const auto frame2 = stream->getNextFrame();
+        ASSERT_NE(frame2, nullptr);
+        ASSERT_EQ(frame2->getFrameNumber(), 5);
+    }
+}
+
 TEST_P(DecodeTest1, seekFrame1Loop)
 {
     // Seek to start
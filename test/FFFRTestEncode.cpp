@@ -30,6 +30,8 @@ struct TestParamsEncode
     EncoderOptions::Preset m_preset;
     bool m_useFiltering;
     bool m_useGOP;
+    bool m_usePipelined;
+    uint32_t m_segments;
 };
 
 static std::vector<TestParamsEncode> g_testDataEncode = {
@@ -48,6 +50,10 @@ static std::vector<TestParamsEncode> g_testDataEncode = {
     {3, "test13.mp4", EncodeType::h264, 55, EncoderOptions::Preset::Veryfast, false, false},
     {3, "test14.mp4", EncodeType::h265, 55, EncoderOptions::Preset::Veryfast, false, false},
     {3, "test15.mp4", EncodeType::h265, 55, EncoderOptions::Preset::Veryfast, true, true},
+    {1, "test16.mp4", EncodeType::h264, 125, EncoderOptions::Preset::Ultrafast, false, false, true},
+    {3, "test17.mp4", EncodeType::h265, 55, EncoderOptions::Preset::Veryfast, true, true, true},
+    {1, "test18.mp4", EncodeType::h264, 125, EncoderOptions::Preset::Ultrafast, false, false, false, 4},
+    {3, "test19.mp4", EncodeType::h265, 55, EncoderOptions::Preset::Veryfast, false, true, false, 4},
 };
 
 class TestEncoder
@@ -101,6 +107,8 @@ TEST_P(EncodeTest1, encodeStream)
     if (GetParam().m_useGOP) {
         options2.m_gopSize = 3;
     }
+    options2.m_pipelined = GetParam().m_usePipelined;
+    options2.m_segments = GetParam().m_segments;
 
     // Just run an encode and see if output is correct manually
     ASSERT_TRUE(Encoder::encodeStream(GetParam().m_fileName, m_decoder.m_stream, options2));
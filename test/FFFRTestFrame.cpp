@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "FFFRDLPack.h"
 #include "FFFRTestData.h"
 #include "FFFrameReader.h"
 
@@ -75,4 +76,36 @@ TEST_P(FrameTest1, getPixelFormat)
     ASSERT_EQ(m_frame->getPixelFormat(), GetParam().m_format);
 }
 
+TEST_P(FrameTest1, toDLPack)
+{
+    auto* const tensor = m_frame->toDLPack(0);
+    ASSERT_NE(tensor, nullptr);
+    ASSERT_EQ(tensor->dl_tensor.device.device_type, kDLCPU);
+    ASSERT_EQ(tensor->dl_tensor.dtype.bits, 8);
+    ASSERT_EQ(tensor->dl_tensor.shape[0], GetParam().m_height);
+    ASSERT_EQ(tensor->dl_tensor.shape[1], GetParam().m_width);
+    // The tensor must reference the frame data directly without copying
+    ASSERT_EQ(tensor->dl_tensor.data, m_frame->getFrameData(0).first);
+    ASSERT_EQ(tensor->dl_tensor.strides[0] * (tensor->dl_tensor.dtype.bits / 8), m_frame->getFrameData(0).second);
+    tensor->deleter(tensor);
+}
+
+TEST_P(FrameTest1, toDLPackLifetime)
+{
+    // The tensor must keep the frame data alive after all other frame references are released
+    auto* const tensor = m_frame->toDLPack(0);
+    ASSERT_NE(tensor, nullptr);
+    const auto* const data = static_cast<uint8_t*>(tensor->dl_tensor.data);
+    m_frame.reset();
+    ASSERT_NE(data, nullptr);
+    // Read through the exported pointer to check the memory is still valid
+    [[maybe_unused]] const auto value = data[0];
+    tensor->deleter(tensor);
+}
+
+TEST_P(FrameTest1, toDLPackInvalidPlane)
+{
+    ASSERT_EQ(m_frame->toDLPack(static_cast<uint32_t>(m_frame->getNumberPlanes())), nullptr);
+}
+
 INSTANTIATE_TEST_SUITE_P(FrameTestData, FrameTest1, ::testing::ValuesIn(g_testData));
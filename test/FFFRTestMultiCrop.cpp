@@ -0,0 +1,99 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRMultiCrop.h"
+#include "FFFRTestData.h"
+#include "FFFrameReader.h"
+
+#include <gtest/gtest.h>
+
+using namespace Ffr;
+
+class MultiCropTest1 : public ::testing::TestWithParam<TestParams>
+{
+protected:
+    MultiCropTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+        const std::vector<Crop> cropList = {
+            {0, 0, 0, 0},
+            {2, 2, 2, 2},
+            {0, static_cast<uint32_t>(GetParam().m_height) / 2, 0, static_cast<uint32_t>(GetParam().m_width) / 2},
+        };
+        m_cropList = cropList;
+        m_multiCrop = Fmc::MultiCrop::getMultiCrop(GetParam().m_fileName, cropList);
+        ASSERT_NE(m_multiCrop, nullptr);
+    }
+
+    void TearDown() override
+    {
+        m_multiCrop.reset();
+    }
+
+    std::vector<Crop> m_cropList;
+    std::shared_ptr<Fmc::MultiCrop> m_multiCrop = nullptr;
+};
+
+TEST_P(MultiCropTest1, getNextFrameGroup)
+{
+    const auto frames = m_multiCrop->getNextFrameGroup();
+    ASSERT_EQ(frames.size(), m_cropList.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        ASSERT_NE(frames[i], nullptr);
+        // Each view must have the cropped dimensions but share the decoded frames position
+        ASSERT_EQ(frames[i]->getWidth(), GetParam().m_width - m_cropList[i].m_left - m_cropList[i].m_right);
+        ASSERT_EQ(frames[i]->getHeight(), GetParam().m_height - m_cropList[i].m_top - m_cropList[i].m_bottom);
+        ASSERT_EQ(frames[i]->getTimeStamp(), frames[0]->getTimeStamp());
+        ASSERT_EQ(frames[i]->getFrameNumber(), frames[0]->getFrameNumber());
+    }
+}
+
+TEST_P(MultiCropTest1, frameGroupSequence)
+{
+    // Consecutive groups must advance through the stream a single frame at a time
+    for (int64_t i = 0; i < 10; i++) {
+        const auto frames = m_multiCrop->getNextFrameGroup();
+        ASSERT_EQ(frames.size(), m_cropList.size());
+        for (const auto& frame : frames) {
+            ASSERT_EQ(frame->getFrameNumber(), i);
+        }
+    }
+}
+
+TEST_P(MultiCropTest1, sharedFrameData)
+{
+    const auto frames = m_multiCrop->getNextFrameGroup();
+    ASSERT_EQ(frames.size(), m_cropList.size());
+    // The views are zero-copy so a crop region must point into the same data as the uncropped view
+    const auto full = frames[0]->getFrameData(0);
+    const auto cropped = frames[1]->getFrameData(0);
+    ASSERT_EQ(cropped.second, full.second);
+    ASSERT_EQ(cropped.first,
+        full.first + static_cast<size_t>(m_cropList[1].m_top) * full.second + m_cropList[1].m_left);
+}
+
+TEST_P(MultiCropTest1, seekFrameGroup)
+{
+    ASSERT_TRUE(m_multiCrop->seekFrame(40));
+    const auto frames = m_multiCrop->getNextFrameGroup();
+    ASSERT_EQ(frames.size(), m_cropList.size());
+    for (const auto& frame : frames) {
+        ASSERT_EQ(frame->getFrameNumber(), 40);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(MultiCropTestData, MultiCropTest1, ::testing::ValuesIn(g_testData));
@@ -296,5 +296,21 @@ TEST_P(SeekTest1, getFramesByIndex)
     }
 }
 
+TEST_P(SeekTest1, getFramesByIndexUnsorted)
+{
+    // Unsorted and duplicated requests must be planned into sorted decode order but returned in the callers order
+    const std::vector<int64_t> framesList1 = {12, 3, 8, 3, 7};
+    const auto frames1 = m_stream->getFramesByIndex(framesList1);
+    if (static_cast<size_t>(std::get<0>(GetParam()).m_bufferLength) >= framesList1.size()) {
+        ASSERT_EQ(frames1.size(), framesList1.size());
+    }
+    // Check that the returned frames are correct
+    auto j = 0;
+    for (auto& i : frames1) {
+        ASSERT_EQ(i->getFrameNumber(), framesList1[j]);
+        ++j;
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(SeekTestData, SeekTest1,
     ::testing::Combine(::testing::ValuesIn(g_testDataStream), ::testing::ValuesIn(g_testData)));
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRTestData.h"
+#include "FFFrameReader.h"
+
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace Ffr;
+
+class SeekIndexTest1 : public ::testing::TestWithParam<TestParams>
+{
+protected:
+    SeekIndexTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+        DecoderOptions options;
+        options.m_seekIndex = true;
+        m_stream = Stream::getStream(GetParam().m_fileName, options);
+        ASSERT_NE(m_stream, nullptr);
+    }
+
+    void TearDown() override
+    {
+        m_stream.reset();
+        // Remove the sidecar index so later test runs start from scratch
+        remove((GetParam().m_fileName + ".ffindex").c_str());
+    }
+
+    std::shared_ptr<Stream> m_stream = nullptr;
+};
+
+TEST_P(SeekIndexTest1, seek)
+{
+    constexpr int64_t seekFrames = 80;
+    const int64_t actualSeek =
+        seekFrames >= GetParam().m_totalFrames ? GetParam().m_totalFrames - 5 : seekFrames;
+    const auto time1 = m_stream->frameToTime(actualSeek);
+    ASSERT_TRUE(m_stream->seek(time1));
+    const auto frame1 = m_stream->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getTimeStamp(), time1);
+}
+
+TEST_P(SeekIndexTest1, seekBackwards)
+{
+    const auto frame1 = GetParam().m_totalFrames - 5;
+    ASSERT_TRUE(m_stream->seekFrame(frame1));
+    const auto ret1 = m_stream->getNextFrame();
+    ASSERT_NE(ret1, nullptr);
+    ASSERT_EQ(ret1->getFrameNumber(), frame1);
+    // Indexed backward seeks should land exactly on the requested frame
+    ASSERT_TRUE(m_stream->seekFrame(5));
+    const auto ret2 = m_stream->getNextFrame();
+    ASSERT_NE(ret2, nullptr);
+    ASSERT_EQ(ret2->getFrameNumber(), 5);
+}
+
+TEST_P(SeekIndexTest1, getFramesByIndexExact)
+{
+    // The per-frame index must land every request on the exact frame first time
+    const std::vector<int64_t> frameSequence = {0, 5, 10, 3, 8};
+    const auto frames = m_stream->getFramesByIndex(frameSequence);
+    ASSERT_EQ(frames.size(), frameSequence.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        ASSERT_EQ(frames[i]->getFrameNumber(), frameSequence[i]);
+    }
+}
+
+TEST_P(SeekIndexTest1, sidecarReuse)
+{
+    // A second stream should load the sidecar written when the first one was opened
+    DecoderOptions options;
+    options.m_seekIndex = true;
+    const auto stream2 = Stream::getStream(GetParam().m_fileName, options);
+    ASSERT_NE(stream2, nullptr);
+    constexpr int64_t seekFrames = 40;
+    const int64_t actualSeek =
+        seekFrames >= GetParam().m_totalFrames ? GetParam().m_totalFrames - 5 : seekFrames;
+    ASSERT_TRUE(stream2->seekFrame(actualSeek));
+    const auto frame1 = stream2->getNextFrame();
+    ASSERT_NE(frame1, nullptr);
+    ASSERT_EQ(frame1->getFrameNumber(), actualSeek);
+}
+
+INSTANTIATE_TEST_SUITE_P(SeekIndexTestData, SeekIndexTest1, ::testing::ValuesIn(g_testData));
@@ -16,6 +16,7 @@
 #include "FFFRTestData.h"
 #include "FFFrameReader.h"
 
+#include <cstdio>
 #include <gtest/gtest.h>
 
 using namespace Ffr;
@@ -75,4 +76,116 @@ TEST_P(StreamTest1, getPixelFormat)
     ASSERT_EQ(m_stream->getPixelFormat(), GetParam().m_format);
 }
 
+TEST_P(StreamTest1, getStats)
+{
+    for (uint32_t i = 0; i < 5; i++) {
+        ASSERT_NE(m_stream->getNextFrame(), nullptr);
+    }
+    ASSERT_TRUE(m_stream->seekFrame(GetParam().m_totalFrames - 5));
+    ASSERT_NE(m_stream->getNextFrame(), nullptr);
+    const auto stats = m_stream->getStats();
+    ASSERT_GE(stats.m_framesDecoded, 6U);
+    ASSERT_GT(stats.m_packetsDemuxed, 0U);
+    ASSERT_GT(stats.m_decodeTime, 0U);
+    ASSERT_EQ(stats.m_seekCount, 1U);
+    // Every recorded seek must land in exactly one distance bucket
+    uint64_t total = 0;
+    for (const auto& bucket : stats.m_seekDistances) {
+        total += bucket;
+    }
+    ASSERT_EQ(total, stats.m_seekCount);
+    ASSERT_GT(stats.m_bufferHighWater, 0U);
+}
+
 INSTANTIATE_TEST_SUITE_P(StreamTestData, StreamTest1, ::testing::ValuesIn(g_testData));
+
+class FastOpenTest1 : public ::testing::TestWithParam<TestParams>
+{
+protected:
+    FastOpenTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+    }
+
+    void TearDown() override
+    {
+        // Remove the sidecar record so later test runs start from scratch
+        remove((GetParam().m_fileName + ".ffmeta").c_str());
+    }
+};
+
+TEST_P(FastOpenTest1, matchesFullOpen)
+{
+    DecoderOptions options;
+    options.m_fastOpen = true;
+    // The first open performs the full scans and writes the sidecar record
+    auto stream = Stream::getStream(GetParam().m_fileName, options);
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(stream->getTotalFrames(), GetParam().m_totalFrames);
+    ASSERT_EQ(stream->getDuration(), GetParam().m_duration);
+    stream.reset();
+    // The second open must report identical properties loaded from the sidecar record
+    stream = Stream::getStream(GetParam().m_fileName, options);
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(stream->getTotalFrames(), GetParam().m_totalFrames);
+    ASSERT_EQ(stream->getDuration(), GetParam().m_duration);
+    const auto frame = stream->getNextFrame();
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(frame->getFrameNumber(), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(FastOpenTestData, FastOpenTest1, ::testing::ValuesIn(g_testData));
+
+class ScrubTest1 : public ::testing::TestWithParam<TestParams>
+{
+protected:
+    ScrubTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+        DecoderOptions options;
+        options.m_scrubMode = true;
+        m_stream = Stream::getStream(GetParam().m_fileName, options);
+        ASSERT_NE(m_stream, nullptr);
+    }
+
+    void TearDown() override
+    {
+        m_stream.reset();
+    }
+
+    std::shared_ptr<Stream> m_stream = nullptr;
+};
+
+TEST_P(ScrubTest1, keyframesOnly)
+{
+    // Scrub mode must still yield frames in order with their true frame numbers
+    int64_t previous = -1;
+    for (uint32_t i = 0; i < 5; i++) {
+        const auto frame = m_stream->getNextFrame();
+        ASSERT_NE(frame, nullptr);
+        ASSERT_GT(frame->getFrameNumber(), previous);
+        previous = frame->getFrameNumber();
+    }
+}
+
+TEST_P(ScrubTest1, runtimeToggle)
+{
+    ASSERT_TRUE(m_stream->getScrubMode());
+    ASSERT_NE(m_stream->getNextFrame(), nullptr);
+    // Disabling scrub mode must restore normal consecutive decoding
+    m_stream->setScrubMode(false);
+    ASSERT_FALSE(m_stream->getScrubMode());
+    ASSERT_TRUE(m_stream->seekFrame(0));
+    auto frame = m_stream->getNextFrame();
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(frame->getFrameNumber(), 0);
+    frame = m_stream->getNextFrame();
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(frame->getFrameNumber(), 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(ScrubTestData, ScrubTest1, ::testing::ValuesIn(g_testData));
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2019 Matthew Oliver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FFFRStreamCache.h"
+#include "FFFRTestData.h"
+#include "FFFrameReader.h"
+
+#include <gtest/gtest.h>
+
+using namespace Ffr;
+
+class StreamCacheTest1 : public ::testing::TestWithParam<TestParams>
+{
+protected:
+    StreamCacheTest1() = default;
+
+    void SetUp() override
+    {
+        setLogLevel(LogLevel::Warning);
+        StreamCache::get().clear();
+    }
+
+    void TearDown() override
+    {
+        StreamCache::get().clear();
+    }
+};
+
+TEST_P(StreamCacheTest1, reuseStream)
+{
+    auto stream = StreamCache::get().getStream(GetParam().m_fileName);
+    ASSERT_NE(stream, nullptr);
+    auto* const pointer = stream.get();
+    stream.reset();
+    // A repeat open with matching options must hand back the warm stream
+    stream = StreamCache::get().getStream(GetParam().m_fileName);
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(stream.get(), pointer);
+}
+
+TEST_P(StreamCacheTest1, resetPosition)
+{
+    auto stream = StreamCache::get().getStream(GetParam().m_fileName);
+    ASSERT_NE(stream, nullptr);
+    for (uint32_t i = 0; i < 5; i++) {
+        ASSERT_NE(stream->getNextFrame(), nullptr);
+    }
+    stream.reset();
+    // The reused stream must behave like a fresh open and start from the first frame
+    stream = StreamCache::get().getStream(GetParam().m_fileName);
+    ASSERT_NE(stream, nullptr);
+    const auto frame = stream->getNextFrame();
+    ASSERT_NE(frame, nullptr);
+    ASSERT_EQ(frame->getFrameNumber(), 0);
+}
+
+TEST_P(StreamCacheTest1, differentOptions)
+{
+    auto stream = StreamCache::get().getStream(GetParam().m_fileName);
+    ASSERT_NE(stream, nullptr);
+    auto* const pointer = stream.get();
+    stream.reset();
+    // A request with a different configuration must not reuse the cached stream
+    DecoderOptions options;
+    options.m_bufferLength = 4;
+    stream = StreamCache::get().getStream(GetParam().m_fileName, options);
+    ASSERT_NE(stream, nullptr);
+    ASSERT_NE(stream.get(), pointer);
+}
+
+TEST_P(StreamCacheTest1, concurrentHandles)
+{
+    // Concurrent requests for the same file must receive independent streams
+    auto stream1 = StreamCache::get().getStream(GetParam().m_fileName);
+    ASSERT_NE(stream1, nullptr);
+    auto stream2 = StreamCache::get().getStream(GetParam().m_fileName);
+    ASSERT_NE(stream2, nullptr);
+    ASSERT_NE(stream1.get(), stream2.get());
+}
+
+INSTANTIATE_TEST_SUITE_P(StreamCacheTestData, StreamCacheTest1, ::testing::ValuesIn(g_testData));